@@ -0,0 +1,551 @@
+// High-Level Explanation:
+// This module is the benchmark and performance-regression harness for the video pipeline.
+// It is built against the stub camera and screen backends in bench/stubs, so it runs on plain Linux without QNX.
+// Each pipeline module (camera capture, ISP, display copy, encoder) and every pixel kernel variant is
+// microbenchmarked at 720p, 1080p, and 4K, and the full stage graph is run end to end to report fps, per-stage
+// latency, and CPU time. Results are written as JSON and optionally compared against a stored baseline.
+
+// Important Functions:
+// - measure: Times an operation over several batches and keeps the fastest batch (least disturbed by noise).
+// - bench_modules/bench_kernels/bench_pipeline: Run the module, kernel, and end-to-end benchmarks.
+// - write_results: Writes all results as JSON.
+// - compare_baseline: Flags results slower than the baseline by more than the tolerance and the noise floor.
+//   Per-stage pipeline latencies are means over every run (outliers included) and are reported but not gated.
+// - main: Parses options, runs the benchmarks, writes results, and compares them.
+
+// Important Variables:
+// - results: Collected benchmark results (name, wall and CPU time per operation, throughput).
+// - min_batch_ns: Minimum wall time of one timing batch (shorter with --quick).
+// - runs: Number of times the whole suite runs (--runs); each result keeps its fastest run, which is far more stable
+//   between invocations than a single run.
+// - recording_path: Scratch file the encoder benchmarks record to (in --scratch, tmpfs by default), deleted afterwards.
+
+// Inputs and Outputs:
+// - Inputs: --output <file>, --baseline <file>, --tolerance <fraction>, --filter <substring>, --scratch <dir>, --runs <n>, --quick.
+// - Outputs: JSON results file, comparison table on stdout, return code (1 on regression).
+
+#include "camera_wrapper.h"
+#include "display.h"
+#include "encoder.h"
+#include "isp.h"
+#include "pipeline.h"
+#include "pixel_kernels.h"
+#include "roi.h"
+#include "stages.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_RESULTS 256
+#define NUM_BATCHES 5
+#define BENCH_DEFAULT_TOLERANCE 0.25   // Keep in sync with BENCH_TOLERANCE in CMakeLists.txt
+#define BENCH_NOISE_FLOOR_NS 2000.0    // Slowdowns smaller than this are timer and scheduler noise, whatever the percentage
+#define BENCH_RECORDING_FRAMES 16      // Recordings are restarted (truncated) after this many frames to bound the scratch file
+
+typedef struct {
+    char name[96];
+    double ns_per_op;     // Wall time per operation (fastest batch)
+    double cpu_ns_per_op; // Process CPU time per operation (same batch, all threads)
+    double mb_per_s;      // Frame bytes processed per second (0 if not meaningful)
+    double max_ns;        // Worst single-run latency (pipeline stages only)
+    int gated;            // Compared against the baseline (fastest-batch timings); 0 for per-stage means, which include outliers
+} bench_result;
+
+typedef struct {
+    const char *name;
+    int width;
+    int height;
+} bench_resolution;
+
+static const bench_resolution resolutions[] = {
+    { "720p", 1280, 720 },
+    { "1080p", 1920, 1080 },
+    { "4k", 3840, 2160 },
+};
+#define NUM_RESOLUTIONS (int)(sizeof(resolutions) / sizeof(resolutions[0]))
+
+static bench_result results[MAX_RESULTS];
+static int num_results = 0;
+static unsigned long long min_batch_ns = 100000000ull;
+static const char *filter = NULL;
+static int saved_stdout = -1;
+static char recording_path[4096];
+
+static unsigned long long clock_ns(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ull + (unsigned long long)ts.tv_nsec;
+}
+
+// The modules log every frame; send stdout to /dev/null while timing
+static void quiet_begin(void) {
+    fflush(stdout);
+    saved_stdout = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd >= 0) {
+        dup2(null_fd, STDOUT_FILENO);
+        close(null_fd);
+    }
+}
+
+static void quiet_end(void) {
+    fflush(stdout);
+    if (saved_stdout >= 0) {
+        dup2(saved_stdout, STDOUT_FILENO);
+        close(saved_stdout);
+        saved_stdout = -1;
+    }
+}
+
+static int selected(const char *name) {
+    return filter == NULL || strstr(name, filter) != NULL;
+}
+
+// Result slot for 'name'; with --runs the same benchmark reports again, and *is_new tells whether the slot is fresh
+static bench_result *add_result(const char *name, int *is_new) {
+    for (int i = 0; i < num_results; i++) {
+        if (strcmp(results[i].name, name) == 0) {
+            *is_new = 0;
+            return &results[i];
+        }
+    }
+    if (num_results == MAX_RESULTS) return NULL;
+    bench_result *r = &results[num_results++];
+    memset(r, 0, sizeof(*r));
+    snprintf(r->name, sizeof(r->name), "%s", name);
+    *is_new = 1;
+    return r;
+}
+
+// Time op(ctx) in NUM_BATCHES batches of at least min_batch_ns and record the fastest batch
+static bench_result *measure(const char *name, void (*op)(void *), void *ctx, size_t bytes_per_op) {
+    double best_wall = 0, best_cpu = 0;
+    quiet_begin();
+    op(ctx); // Warm up caches and lazy allocations
+    for (int b = 0; b < NUM_BATCHES; b++) {
+        unsigned long long wall_start = clock_ns(CLOCK_MONOTONIC);
+        unsigned long long cpu_start = clock_ns(CLOCK_PROCESS_CPUTIME_ID);
+        unsigned long long elapsed;
+        long iterations = 0;
+        do {
+            op(ctx);
+            iterations++;
+            elapsed = clock_ns(CLOCK_MONOTONIC) - wall_start;
+        } while (elapsed < min_batch_ns || iterations < 2);
+        double wall = (double)elapsed / iterations;
+        double cpu = (double)(clock_ns(CLOCK_PROCESS_CPUTIME_ID) - cpu_start) / iterations;
+        if (b == 0 || wall < best_wall) {
+            best_wall = wall;
+            best_cpu = cpu;
+        }
+    }
+    quiet_end();
+
+    int is_new;
+    bench_result *r = add_result(name, &is_new);
+    if (!r) return NULL;
+    if (is_new || best_wall < r->ns_per_op) { // Keep the fastest run
+        r->ns_per_op = best_wall;
+        r->cpu_ns_per_op = best_cpu;
+        r->gated = 1;
+        if (bytes_per_op) r->mb_per_s = (double)bytes_per_op / best_wall * 1000.0;
+    }
+    printf("%-40s %12.0f ns/op %10.1f MB/s\n", name, best_wall, bytes_per_op ? (double)bytes_per_op / best_wall * 1000.0 : 0.0);
+    return r;
+}
+
+static unsigned char *make_frame(int width, int height) {
+    size_t size = (size_t)width * height * 3;
+    unsigned char *frame = (unsigned char *)malloc(size);
+    if (frame) {
+        for (size_t i = 0; i < size; i++) frame[i] = (unsigned char)(i * 13);
+    }
+    return frame;
+}
+
+// ---- Module benchmarks ----
+
+typedef struct {
+    const bench_resolution *res;
+    unsigned char *frame;
+    unsigned char *out;
+    CameraWrapper *camera;
+    isp *isp_camera;
+    display *screen;
+    encoder *recorder;
+    const pixel_kernels *kernels;
+    pipeline_frame roi_view; // Centered half-width, half-height view of frame
+    int counter;
+} module_ctx;
+
+static void op_capture(void *arg) {
+    module_ctx *c = (module_ctx *)arg;
+    unsigned char *data;
+    int width, height;
+    camera_capture_frame(c->camera, &data, &width, &height);
+}
+
+static void op_isp(void *arg) {
+    module_ctx *c = (module_ctx *)arg;
+    int width, height;
+    isp_program_R0(c->isp_camera, c->frame, c->res->width, c->res->height);
+    isp_program_R1(c->isp_camera, c->frame, c->res->width, c->res->height);
+    isp_get_current_buffer(c->isp_camera, &width, &height);
+}
+
+static void op_display(void *arg) {
+    module_ctx *c = (module_ctx *)arg;
+    display_display_data(c->screen, c->frame, c->res->width, c->res->height, c->counter++ & 1);
+}
+
+static void op_display_roi(void *arg) {
+    module_ctx *c = (module_ctx *)arg;
+    pipeline_frame *v = &c->roi_view;
+    display_display_view(c->screen, v->data, v->width, v->height, v->stride, c->counter++ & 1);
+}
+
+// Truncate the scratch recording by stopping and restarting saving (the reopen is part of the measured cost)
+static void restart_recording(encoder *recorder, int *frames) {
+    if (++*frames % BENCH_RECORDING_FRAMES == 0) {
+        encoder_stop_saving(recorder);
+        encoder_start_saving(recorder);
+    }
+}
+
+static void op_encoder(void *arg) {
+    module_ctx *c = (module_ctx *)arg;
+    encoder_encode_frame(c->recorder, c->frame, c->res->width, c->res->height);
+    restart_recording(c->recorder, &c->counter);
+}
+
+static void op_blend(void *arg) {
+    module_ctx *c = (module_ctx *)arg;
+    c->kernels->blend(c->out, c->frame, (size_t)c->res->width * c->res->height * 3, 96);
+}
+
+static void op_gain(void *arg) {
+    module_ctx *c = (module_ctx *)arg;
+    c->kernels->gain(c->out, c->frame, (size_t)c->res->width * c->res->height * 3, 320);
+}
+
+// Halve the frame vertically, as a 2:1 scaler would
+static void op_average_rows(void *arg) {
+    module_ctx *c = (module_ctx *)arg;
+    size_t row = (size_t)c->res->width * 3;
+    for (int y = 0; y + 1 < c->res->height; y += 2) {
+        c->kernels->average_rows(c->out + (y / 2) * row, c->frame + y * row, c->frame + (y + 1) * row, row);
+    }
+}
+
+// Zoom the quarter-area view 2x back to the full frame, as display_zoom2x does
+static void op_scale_nearest(void *arg) {
+    module_ctx *c = (module_ctx *)arg;
+    pipeline_frame *v = &c->roi_view;
+    roi_scale_nearest(c->kernels, v->data, v->width, v->height, v->stride, c->out, c->res->width, c->res->height, c->res->width * 3);
+}
+
+static void bench_modules(const bench_resolution *res) {
+    module_ctx c;
+    char name[96];
+    size_t frame_bytes = (size_t)res->width * res->height * 3;
+    memset(&c, 0, sizeof(c));
+    c.res = res;
+    c.frame = make_frame(res->width, res->height);
+    if (!c.frame) return;
+
+    snprintf(name, sizeof(name), "capture/%s", res->name);
+    if (selected(name)) {
+        c.camera = camera_init(res->width, res->height);
+        if (c.camera) {
+            measure(name, op_capture, &c, 0); // Only hands buffers back and forth
+            camera_release(c.camera);
+        }
+    }
+
+    snprintf(name, sizeof(name), "isp/%s", res->name);
+    if (selected(name) && isp_init(&c.isp_camera, NULL) == 0) {
+        measure(name, op_isp, &c, 0); // Only swaps buffer pointers
+        isp_uninit(c.isp_camera);
+    }
+
+    snprintf(name, sizeof(name), "display/%s", res->name);
+    if (selected(name) && display_init(&c.screen, NULL) == 0) {
+        measure(name, op_display, &c, frame_bytes);
+        display_uninit(c.screen);
+    }
+
+    // Quarter-area ROI: shown at its own size (plain copy), then zoomed 2x to the full window (scaler)
+    pipeline_frame full = { c.frame, res->width, res->height, res->width * 3, PIPELINE_FORMAT_RGB888, 0 };
+    roi_rect quarter = { res->width / 4, res->height / 4, res->width / 2, res->height / 2 };
+    roi_make_view(&full, &quarter, &c.roi_view);
+    snprintf(name, sizeof(name), "display_roi/%s", res->name);
+    if (selected(name) && display_init(&c.screen, NULL) == 0) {
+        measure(name, op_display_roi, &c, frame_bytes / 4);
+        display_uninit(c.screen);
+    }
+    snprintf(name, sizeof(name), "display_zoom2x/%s", res->name);
+    if (selected(name) && display_init(&c.screen, NULL) == 0) {
+        display_set_output_size(c.screen, res->width, res->height);
+        measure(name, op_display_roi, &c, frame_bytes);
+        display_uninit(c.screen);
+    }
+
+    // The encoder writes every frame to a real file, as it does while saving in the app
+    snprintf(name, sizeof(name), "encoder/%s", res->name);
+    if (selected(name) && encoder_init(&c.recorder, recording_path) == 0) {
+        if (encoder_start_saving(c.recorder) == 0) {
+            c.counter = 0;
+            measure(name, op_encoder, &c, frame_bytes);
+            encoder_stop_saving(c.recorder);
+        }
+        encoder_uninit(c.recorder);
+        unlink(recording_path);
+    }
+
+    free(c.frame);
+}
+
+static void bench_kernels(const bench_resolution *res) {
+    static const struct {
+        const char *name;
+        void (*op)(void *);
+    } kernels[] = {
+        { "blend", op_blend },
+        { "gain", op_gain },
+        { "average_rows", op_average_rows },
+        { "scale_nearest", op_scale_nearest },
+    };
+    module_ctx c;
+    size_t frame_bytes = (size_t)res->width * res->height * 3;
+    memset(&c, 0, sizeof(c));
+    c.res = res;
+    c.frame = make_frame(res->width, res->height);
+    c.out = make_frame(res->width, res->height);
+    if (!c.frame || !c.out) {
+        free(c.frame);
+        free(c.out);
+        return;
+    }
+    pipeline_frame full = { c.frame, res->width, res->height, res->width * 3, PIPELINE_FORMAT_RGB888, 0 };
+    roi_rect quarter = { res->width / 4, res->height / 4, res->width / 2, res->height / 2 };
+    roi_make_view(&full, &quarter, &c.roi_view);
+
+    for (int isa = 0; isa < PIXEL_ISA_COUNT; isa++) {
+        c.kernels = pixel_kernels_get_variant((pixel_isa)isa);
+        if (!c.kernels) continue;
+        for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+            char name[96];
+            snprintf(name, sizeof(name), "kernel/%s/%s/%s", c.kernels->name, kernels[k].name, res->name);
+            if (selected(name)) measure(name, kernels[k].op, &c, frame_bytes);
+        }
+    }
+
+    free(c.frame);
+    free(c.out);
+}
+
+// ---- End-to-end pipeline ----
+
+typedef struct {
+    pipeline *graph;
+    encoder *recorder;
+    int frames;
+} pipeline_ctx;
+
+static void op_pipeline(void *arg) {
+    pipeline_ctx *p = (pipeline_ctx *)arg;
+    pipeline_process(p->graph);
+    restart_recording(p->recorder, &p->frames);
+}
+
+static void bench_pipeline(const bench_resolution *res) {
+    char name[96];
+    snprintf(name, sizeof(name), "pipeline/%s/frame", res->name);
+    if (!selected(name)) return;
+
+    stages_context ctx;
+    pipeline *graph = NULL;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.camera = camera_init(res->width, res->height);
+    int ok = ctx.camera != NULL &&
+             isp_init(&ctx.isp_camera, NULL) == 0 &&
+             display_init(&ctx.screen, NULL) == 0 &&
+             encoder_init(&ctx.recorder, recording_path) == 0 &&
+             pipeline_init(&graph, 0) == 0 &&
+             stages_register(graph, &ctx) == 0 &&
+             encoder_start_saving(ctx.recorder) == 0;
+
+    if (ok) {
+        pipeline_ctx run = { graph, ctx.recorder, 0 };
+        bench_result *frame = measure(name, op_pipeline, &run, (size_t)res->width * res->height * 3);
+        if (frame) printf("%-40s %12.1f fps %10.0f cpu ns/frame\n", "", 1e9 / frame->ns_per_op, frame->cpu_ns_per_op);
+
+        for (int i = 0; i < pipeline_stage_count(graph); i++) {
+            pipeline_stage_stats stats;
+            if (pipeline_get_stage_stats(graph, i, &stats) != 0 || stats.runs == 0) continue;
+            char stage_name[96];
+            snprintf(stage_name, sizeof(stage_name), "pipeline/%s/stage/%s", res->name, stats.name);
+            int is_new;
+            bench_result *r = add_result(stage_name, &is_new);
+            if (!r) break;
+            double mean = (double)stats.total_ns / stats.runs;
+            if (is_new || mean < r->ns_per_op) r->ns_per_op = mean;
+            if (is_new || (double)stats.max_ns > r->max_ns) r->max_ns = (double)stats.max_ns;
+            printf("%-40s %12.0f ns/op %10.0f ns max\n", r->name, mean, (double)stats.max_ns);
+        }
+    } else {
+        printf("Failed to set up pipeline benchmark at %s\n", res->name);
+    }
+
+    if (graph) pipeline_uninit(graph);
+    if (ctx.recorder) {
+        encoder_stop_saving(ctx.recorder);
+        encoder_uninit(ctx.recorder);
+        unlink(recording_path);
+    }
+    if (ctx.screen) display_uninit(ctx.screen);
+    if (ctx.isp_camera) isp_uninit(ctx.isp_camera);
+    if (ctx.camera) camera_release(ctx.camera);
+}
+
+// ---- Results and baseline comparison ----
+
+static int write_results(const char *path, double tolerance) {
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        printf("Failed to open results file: %s\n", path);
+        return -1;
+    }
+    fprintf(out, "{\n  \"kernels\": \"%s\",\n  \"tolerance\": %.3f,\n  \"results\": {\n", pixel_kernels_get()->name, tolerance);
+    for (int i = 0; i < num_results; i++) {
+        bench_result *r = &results[i];
+        fprintf(out, "    \"%s\": { \"ns_per_op\": %.1f, \"cpu_ns_per_op\": %.1f, \"mb_per_s\": %.1f, \"max_ns\": %.1f }%s\n",
+                r->name, r->ns_per_op, r->cpu_ns_per_op, r->mb_per_s, r->max_ns, i + 1 < num_results ? "," : "");
+    }
+    fprintf(out, "  }\n}\n");
+    return fclose(out) == 0 ? 0 : -1;
+}
+
+static char *read_file(const char *path) {
+    FILE *in = fopen(path, "rb");
+    if (!in) return NULL;
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    char *text = size >= 0 ? (char *)malloc((size_t)size + 1) : NULL;
+    if (text) {
+        size_t n = fread(text, 1, (size_t)size, in);
+        text[n] = '\0';
+    }
+    fclose(in);
+    return text;
+}
+
+// Find "<name>": { "ns_per_op": <value> in a results file written by write_results
+static int baseline_value(const char *text, const char *name, double *value) {
+    char key[sizeof(results[0].name) + 4]; // Quotes, colon, and terminator around a result name
+    snprintf(key, sizeof(key), "\"%.*s\":", (int)(sizeof(results[0].name) - 1), name);
+    const char *entry = strstr(text, key);
+    if (!entry) return -1;
+    const char *field = strstr(entry, "\"ns_per_op\":");
+    const char *end = strchr(entry, '}');
+    if (!field || (end && field > end)) return -1;
+    *value = strtod(field + strlen("\"ns_per_op\":"), NULL);
+    return *value > 0 ? 0 : -1;
+}
+
+static int compare_baseline(const char *path, double tolerance) {
+    char *text = read_file(path);
+    if (!text) {
+        printf("Failed to read baseline: %s\n", path);
+        return -1;
+    }
+
+    int regressions = 0;
+    printf("\n%-40s %14s %14s %9s\n", "benchmark", "baseline ns", "current ns", "change");
+    for (int i = 0; i < num_results; i++) {
+        bench_result *r = &results[i];
+        double base;
+        if (baseline_value(text, r->name, &base) != 0) {
+            printf("%-40s %14s %14.0f %9s\n", r->name, "-", r->ns_per_op, "new");
+            continue;
+        }
+        double change = (r->ns_per_op - base) / base;
+        int regressed = r->gated && change > tolerance && r->ns_per_op - base > BENCH_NOISE_FLOOR_NS;
+        regressions += regressed;
+        const char *note = "";
+        if (regressed) {
+            note = "  REGRESSION";
+        } else if (!r->gated) {
+            note = "  (not gated)";
+        } else if (change > tolerance) {
+            note = "  (below noise floor)";
+        }
+        printf("%-40s %14.0f %14.0f %+8.1f%%%s\n", r->name, base, r->ns_per_op, change * 100.0, note);
+    }
+    free(text);
+    printf("\n%d regression(s) beyond %.0f%% tolerance and %.0f ns\n", regressions, tolerance * 100.0, BENCH_NOISE_FLOOR_NS);
+    return regressions ? 1 : 0;
+}
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [--output <file>] [--baseline <file>] [--tolerance <fraction>] [--filter <substring>] [--scratch <dir>] [--runs <n>] [--quick]\n", prog);
+}
+
+int main(int argc, char **argv) {
+    const char *output_path = "bench_results.json";
+    const char *baseline_path = NULL;
+    const char *scratch_dir = access("/dev/shm", W_OK) == 0 ? "/dev/shm" : "/tmp";
+    double tolerance = BENCH_DEFAULT_TOLERANCE;
+    int runs = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output_path = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = atoi(argv[++i]);
+            if (runs < 1) runs = 1;
+        } else if (strcmp(argv[i], "--scratch") == 0 && i + 1 < argc) {
+            scratch_dir = argv[++i];
+        } else if (strcmp(argv[i], "--quick") == 0) {
+            min_batch_ns = 20000000ull;
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    snprintf(recording_path, sizeof(recording_path), "%s/bench_recording_%ld.raw", scratch_dir, (long)getpid());
+
+    if (pixel_kernels_self_check() != 0) {
+        printf("Pixel kernel variants disagree with the scalar reference!\n");
+        return 1;
+    }
+
+    for (int run = 0; run < runs; run++) {
+        if (runs > 1) printf("Run %d of %d\n", run + 1, runs);
+        for (int i = 0; i < NUM_RESOLUTIONS; i++) {
+            bench_modules(&resolutions[i]);
+            bench_kernels(&resolutions[i]);
+            bench_pipeline(&resolutions[i]);
+        }
+    }
+
+    if (write_results(output_path, tolerance) != 0) return 1;
+    printf("Results written to %s\n", output_path);
+
+    if (baseline_path) {
+        int status = compare_baseline(baseline_path, tolerance);
+        return status == 0 ? 0 : 1;
+    }
+    return 0;
+}
@@ -0,0 +1,34 @@
+#ifndef STUB_CAMERA_H
+#define STUB_CAMERA_H
+// High-Level Explanation:
+// Host stand-in for the QNX Camera Framework header, used by the bench target on plain Linux.
+// It declares only the subset of the API used by camera_wrapper.c; camera_stub.c synthesizes frames in memory.
+
+#include <stddef.h>
+
+typedef int camera_handle_t;
+typedef int camera_error_t;
+typedef int camera_unit_t;
+typedef int camera_mode_t;
+
+typedef struct {
+    void *data;
+    size_t size;
+} camera_buffer_t;
+
+#define CAMERA_EOK 0
+#define CAMERA_EINVAL 22
+#define CAMERA_UNIT_0 0
+#define CAMERA_MODE_RW 3
+#define CAMERA_TIMEOUT_INFINITE (-1)
+
+camera_error_t camera_open(camera_unit_t unit, camera_mode_t mode, camera_handle_t *handle);
+camera_error_t camera_close(camera_handle_t handle);
+camera_error_t camera_set_videomode(camera_handle_t handle, int width, int height, int fps);
+camera_error_t camera_set_buffers(camera_handle_t handle, int count, camera_buffer_t *buffers);
+camera_error_t camera_start(camera_handle_t handle);
+camera_error_t camera_stop(camera_handle_t handle);
+camera_error_t camera_get_frame(camera_handle_t handle, camera_buffer_t *buffers, int *index, int timeout);
+camera_error_t camera_release_frame(camera_handle_t handle, int index);
+
+#endif
@@ -0,0 +1,86 @@
+// Synthetic camera for the bench target: buffers are filled with a gradient once, and each
+// captured frame only stamps its sequence number, so capture cost reflects the wrapper, not the stub.
+// Like the real driver, a buffer is not refilled until the application releases it.
+#include <camera/camera.h>
+#include <string.h>
+
+#define STUB_MAX_BUFFERS 16
+
+static camera_buffer_t *stub_buffers = NULL;
+static int stub_count = 0;
+static int stub_next = 0;
+static unsigned int stub_sequence = 0;
+static int stub_open = 0;
+static int stub_in_use[STUB_MAX_BUFFERS];
+
+camera_error_t camera_open(camera_unit_t unit, camera_mode_t mode, camera_handle_t *handle) {
+    (void)unit;
+    (void)mode;
+    if (!handle || stub_open) return CAMERA_EINVAL;
+    stub_open = 1;
+    *handle = 1;
+    return CAMERA_EOK;
+}
+
+camera_error_t camera_close(camera_handle_t handle) {
+    (void)handle;
+    stub_open = 0;
+    stub_buffers = NULL;
+    stub_count = 0;
+    return CAMERA_EOK;
+}
+
+camera_error_t camera_set_videomode(camera_handle_t handle, int width, int height, int fps) {
+    (void)handle;
+    (void)width;
+    (void)height;
+    (void)fps;
+    return CAMERA_EOK;
+}
+
+camera_error_t camera_set_buffers(camera_handle_t handle, int count, camera_buffer_t *buffers) {
+    (void)handle;
+    if (count <= 0 || count > STUB_MAX_BUFFERS || !buffers) return CAMERA_EINVAL;
+    stub_buffers = buffers;
+    stub_count = count;
+    stub_next = 0;
+    memset(stub_in_use, 0, sizeof(stub_in_use));
+    for (int i = 0; i < count; i++) {
+        unsigned char *p = (unsigned char *)buffers[i].data;
+        for (size_t j = 0; j < buffers[i].size; j++) p[j] = (unsigned char)(j * 7 + i);
+    }
+    return CAMERA_EOK;
+}
+
+camera_error_t camera_start(camera_handle_t handle) {
+    (void)handle;
+    return stub_buffers ? CAMERA_EOK : CAMERA_EINVAL;
+}
+
+camera_error_t camera_stop(camera_handle_t handle) {
+    (void)handle;
+    return CAMERA_EOK;
+}
+
+camera_error_t camera_get_frame(camera_handle_t handle, camera_buffer_t *buffers, int *index, int timeout) {
+    (void)handle;
+    (void)buffers;
+    (void)timeout;
+    if (!stub_buffers || !index) return CAMERA_EINVAL;
+    int tries = 0;
+    while (stub_in_use[stub_next] && tries++ < stub_count) stub_next = (stub_next + 1) % stub_count;
+    if (stub_in_use[stub_next]) return CAMERA_EINVAL; // Every buffer is still owned by the application
+    *index = stub_next;
+    stub_in_use[*index] = 1;
+    stub_next = (stub_next + 1) % stub_count;
+    stub_sequence++;
+    memcpy(stub_buffers[*index].data, &stub_sequence, sizeof(stub_sequence));
+    return CAMERA_EOK;
+}
+
+camera_error_t camera_release_frame(camera_handle_t handle, int index) {
+    (void)handle;
+    if (index < 0 || index >= stub_count) return CAMERA_EINVAL;
+    stub_in_use[index] = 0;
+    return CAMERA_EOK;
+}
@@ -0,0 +1,44 @@
+#ifndef STUB_SCREEN_H
+#define STUB_SCREEN_H
+// High-Level Explanation:
+// Host stand-in for the QNX Screen API header, used by the bench target on plain Linux.
+// It declares only the subset of the API used by display.c; screen_stub.c renders into plain memory buffers.
+
+typedef struct stub_screen_context *screen_context_t;
+typedef struct stub_screen_window *screen_window_t;
+typedef struct stub_screen_buffer *screen_buffer_t;
+typedef struct stub_screen_event *screen_event_t;
+
+#define SCREEN_APPLICATION_CONTEXT 0
+
+#define SCREEN_PROPERTY_FORMAT 1
+#define SCREEN_PROPERTY_USAGE 2
+#define SCREEN_PROPERTY_BUFFER_SIZE 3
+#define SCREEN_PROPERTY_SIZE 4
+#define SCREEN_PROPERTY_RENDER_BUFFERS 5
+#define SCREEN_PROPERTY_POINTER 6
+#define SCREEN_PROPERTY_TYPE 7
+#define SCREEN_PROPERTY_KEY_CODE 8
+
+#define SCREEN_FORMAT_RGB888 1
+#define SCREEN_USAGE_WRITE (1 << 1)
+#define SCREEN_USAGE_NATIVE (1 << 3)
+#define SCREEN_EVENT_NONE 0
+#define SCREEN_EVENT_KEYBOARD 1
+
+int screen_create_context(screen_context_t *ctx, int flags);
+int screen_destroy_context(screen_context_t ctx);
+int screen_create_window(screen_window_t *win, screen_context_t ctx);
+int screen_destroy_window(screen_window_t win);
+int screen_set_window_property_iv(screen_window_t win, int pname, const int *param);
+int screen_get_window_property_pv(screen_window_t win, int pname, void **param);
+int screen_create_window_buffers(screen_window_t win, int count);
+int screen_destroy_buffer(screen_buffer_t buf);
+int screen_get_buffer_property_pv(screen_buffer_t buf, int pname, void **param);
+int screen_post_window(screen_window_t win, screen_buffer_t buf, int count, const int *dirty_rects, int flags);
+int screen_create_event(screen_event_t *event);
+int screen_destroy_event(screen_event_t event);
+int screen_get_event(screen_context_t ctx, screen_event_t event, long long timeout);
+int screen_get_event_property_iv(screen_event_t event, int pname, int *param);
+
+#endif
@@ -0,0 +1,127 @@
+// Headless screen for the bench target: windows own one memory buffer, posting is a no-op,
+// and no input events are ever delivered.
+#include <screen/screen.h>
+#include <stdlib.h>
+
+struct stub_screen_context {
+    int unused;
+};
+
+struct stub_screen_buffer {
+    void *pixels;
+};
+
+struct stub_screen_window {
+    int buffer_size[2];
+    struct stub_screen_buffer *buffer;
+};
+
+struct stub_screen_event {
+    int type;
+};
+
+int screen_create_context(screen_context_t *ctx, int flags) {
+    (void)flags;
+    *ctx = (screen_context_t)calloc(1, sizeof(struct stub_screen_context));
+    return *ctx ? 0 : -1;
+}
+
+int screen_destroy_context(screen_context_t ctx) {
+    free(ctx);
+    return 0;
+}
+
+int screen_create_window(screen_window_t *win, screen_context_t ctx) {
+    (void)ctx;
+    *win = (screen_window_t)calloc(1, sizeof(struct stub_screen_window));
+    return *win ? 0 : -1;
+}
+
+static void free_window_buffer(screen_window_t win) {
+    if (win->buffer) {
+        free(win->buffer->pixels);
+        free(win->buffer);
+        win->buffer = NULL;
+    }
+}
+
+int screen_destroy_window(screen_window_t win) {
+    if (!win) return -1;
+    free_window_buffer(win);
+    free(win);
+    return 0;
+}
+
+int screen_set_window_property_iv(screen_window_t win, int pname, const int *param) {
+    if (!win || !param) return -1;
+    if (pname == SCREEN_PROPERTY_BUFFER_SIZE) {
+        win->buffer_size[0] = param[0];
+        win->buffer_size[1] = param[1];
+    }
+    return 0;
+}
+
+int screen_get_window_property_pv(screen_window_t win, int pname, void **param) {
+    if (!win || !param || pname != SCREEN_PROPERTY_RENDER_BUFFERS) return -1;
+    *param = win->buffer;
+    return 0;
+}
+
+int screen_create_window_buffers(screen_window_t win, int count) {
+    if (!win || count != 1) return -1;
+    free_window_buffer(win);
+    win->buffer = (struct stub_screen_buffer *)malloc(sizeof(struct stub_screen_buffer));
+    if (!win->buffer) return -1;
+    win->buffer->pixels = malloc((size_t)win->buffer_size[0] * win->buffer_size[1] * 3);
+    if (!win->buffer->pixels) {
+        free(win->buffer);
+        win->buffer = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+// Window buffers are owned by their window and freed with it
+int screen_destroy_buffer(screen_buffer_t buf) {
+    (void)buf;
+    return 0;
+}
+
+int screen_get_buffer_property_pv(screen_buffer_t buf, int pname, void **param) {
+    if (!buf || !param || pname != SCREEN_PROPERTY_POINTER) return -1;
+    *param = buf->pixels;
+    return 0;
+}
+
+int screen_post_window(screen_window_t win, screen_buffer_t buf, int count, const int *dirty_rects, int flags) {
+    (void)win;
+    (void)buf;
+    (void)count;
+    (void)dirty_rects;
+    (void)flags;
+    return 0;
+}
+
+int screen_create_event(screen_event_t *event) {
+    *event = (screen_event_t)calloc(1, sizeof(struct stub_screen_event));
+    return *event ? 0 : -1;
+}
+
+int screen_destroy_event(screen_event_t event) {
+    free(event);
+    return 0;
+}
+
+int screen_get_event(screen_context_t ctx, screen_event_t event, long long timeout) {
+    (void)ctx;
+    (void)timeout;
+    if (!event) return -1;
+    event->type = SCREEN_EVENT_NONE;
+    return 0;
+}
+
+int screen_get_event_property_iv(screen_event_t event, int pname, int *param) {
+    if (!event || !param) return -1;
+    *param = pname == SCREEN_PROPERTY_TYPE ? event->type : 0;
+    return 0;
+}
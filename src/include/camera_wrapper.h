@@ -2,47 +2,41 @@
 #define CAMERA_WRAPPER_H
 // High-Level Explanation:
 // This module provides a wrapper around the QNX Camera Framework to manage camera input and frame capture on QNX systems.
-// It supports capturing frames, toggling video saving to a file, and integrates with the broader application for real-time video processing.
-// The code is designed to replace an OpenCV-based implementation, supporting toggle saving with 's' and exit with 'q' in a QNX environment.
-// Important functions handle camera initialization, frame capture, saving control, and resource cleanup.
-// Key variables include the camera handle, buffers, resolution settings, saving state, and output file path.
+// It supports capturing frames and holding them past the next capture, and integrates with the broader application for real-time video processing.
+// Saving video is done by the encoder stage (encoder.h), which records what the pipeline passes it.
+// The code is designed to replace an OpenCV-based implementation in a QNX environment.
+// Important functions handle camera initialization, frame capture, buffer holds, and resource cleanup.
+// Key variables include the camera handle, buffers, and resolution settings.
 
 // Important Functions:
-// - camera_init: Initializes the camera with specified width, height, and output filename.
-// - camera_capture_frame: Captures a frame and provides raw pixel data.
-// - camera_start_saving: Opens the output file for saving frames.
-// - camera_stop_saving: Stops saving and closes the file.
-// - camera_is_saving: Checks if saving is active.
+// - camera_init: Initializes the camera with specified width and height.
+// - camera_capture_frame: Captures a frame and provides raw pixel data (valid until the next capture).
+// - camera_hold_frame/camera_release_held_frame: Keep a captured frame alive past the next capture without copying.
 // - camera_release: Releases camera resources.
 
 // Important Variables:
 // - camera_handle: QNX camera handle for capturing frames.
 // - buffers: Array of frame buffers for capturing data.
+// - holds: Per-buffer hold counts; held buffers are not returned to the camera.
 // - width/height: Resolution settings for the camera.
-// - is_saving: Flag indicating if saving is active.
-// - output_path: Path for the output video file.
-// - output_file: File handle for saving raw frames.
 
 // Inputs and Outputs:
-// - Inputs: width (int), height (int), output_path (const char*).
+// - Inputs: width (int), height (int).
 // - Outputs: data (unsigned char**), width (int*), height (int*), return codes (int).
 
 typedef struct CameraQNX CameraWrapper;
 
-// Initialize the camera with width, height, and output file path for saving
-CameraWrapper* camera_init(int width, int height, const char* output_path);
+// Initialize the camera with width and height
+CameraWrapper* camera_init(int width, int height);
 
-// Capture a frame (returns pointer to raw pixel data and dimensions)
+// Capture a frame (returns pointer to raw pixel data and dimensions, valid until the next capture)
 int camera_capture_frame(CameraWrapper* camera, unsigned char** data, int* width, int* height);
 
-// Start saving video to the output path
-int camera_start_saving(CameraWrapper* camera);
+// Hold a captured frame so the camera does not reuse its buffer (fails if too many frames are held)
+int camera_hold_frame(CameraWrapper* camera, const unsigned char* data);
 
-// Stop saving video
-int camera_stop_saving(CameraWrapper* camera);
-
-// Check if the camera is currently saving
-int camera_is_saving(CameraWrapper* camera);
+// Drop a hold taken with camera_hold_frame
+int camera_release_held_frame(CameraWrapper* camera, const unsigned char* data);
 
 // Release resources
 void camera_release(CameraWrapper* camera);
@@ -2,7 +2,7 @@
 #define DISPLAY_H
 // High-Level Explanation:
 // This module manages the display of video frames on QNX systems using the QNX Screen API.
-// It creates a window, renders frames, overlays a saving status, and detects keypresses for user interaction ('s' to toggle saving, 'q' to quit).
+// It creates a window, renders frames, overlays a saving status, and detects keypresses for user interaction ('s' to toggle saving, 'p' for a snapshot, 'z' to zoom, 'q' to quit).
 // The code is part of a QNX-based video pipeline, replacing OpenCV display functionality.
 // Important functions initialize the display, render frames, capture keypresses, and clean up resources.
 // Key variables include the screen context, window, buffer, and frame dimensions.
@@ -11,16 +11,19 @@
 // - display_init: Initializes the display with a callback for frame processing.
 // - display_uninit: Releases display resources.
 // - display_display_data: Renders a frame with a saving status overlay.
-// - display_get_keypress: Captures user keypresses ('s' or 'q').
+// - display_display_view: Renders a strided view (e.g. a region of interest), scaling it only if an output size is set.
+// - display_set_output_size: Fixes the window size (0 x 0 follows the size of each frame).
+// - display_get_keypress: Captures user keypresses ('s', 'p', 'z', or 'q').
 
 // Important Variables:
 // - screen_ctx: QNX Screen context for managing the display.
 // - screen_win: QNX Screen window for rendering frames.
 // - screen_buf: Buffer for storing frame data.
 // - width/height: Dimensions of the displayed frame.
+// - out_width/out_height: Requested window size (0 to follow the frame size).
 
 // Inputs and Outputs:
-// - Inputs: display_callback (void (*)), data (unsigned char*), width (int), height (int), is_saving (int).
+// - Inputs: display_callback (void (*)), data (unsigned char*), width (int), height (int), stride (int), is_saving (int).
 // - Outputs: Return codes (int), keypress (int).
 typedef struct display display;
 
@@ -33,7 +36,13 @@ int display_uninit(display *disp);
 // Display the frame data with saving status
 int display_display_data(display *disp, unsigned char *data, int width, int height, int is_saving);
 
-// Get the next keypress (for 's' to toggle saving, 'q' to quit)
+// Display a strided view (stride = bytes between rows) with saving status
+int display_display_view(display *disp, const unsigned char *data, int width, int height, int stride, int is_saving);
+
+// Fix the window size; views of another size are scaled to it (0 x 0 follows the frame size)
+int display_set_output_size(display *disp, int width, int height);
+
+// Get the next keypress (for 's' to toggle saving, 'p' for a snapshot, 'z' to zoom, 'q' to quit)
 int display_get_keypress(void);
 
 #endif
\ No newline at end of file
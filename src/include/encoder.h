@@ -2,7 +2,8 @@
 #define ENCODER_H
 // High-Level Explanation:
 // This module manages video encoding on QNX systems by writing raw frame data to a file.
-// It operates in a separate thread, encoding frames when saving is active, and finalizes the recording process.
+// It runs as the encode stage of the pipeline and owns the recording: starting to save opens the output file, every frame
+// (or region-of-interest view) passed in while saving is appended to it, and stopping closes it.
 // The code replaces an OpenCV-based encoder, supporting toggle saving functionality in a QNX video pipeline.
 // Important functions initialize the encoder, encode frames, and finalize recording.
 // Key variables include the output filename, frame count, and file handle.
@@ -10,16 +11,20 @@
 // Important Functions:
 // - encoder_init: Initializes the encoder with an output file path.
 // - encoder_uninit: Cleans up encoder resources.
+// - encoder_start_saving/encoder_stop_saving: Open and close the output file ('s' key).
+// - encoder_is_saving: Checks if saving is active.
 // - encoder_encode_frame: Writes a frame to the output file if saving is active.
+// - encoder_encode_view: Same as encoder_encode_frame for a strided view (e.g. a region of interest), writing only its pixels.
 // - encoder_finalize_recording: Closes the output file and finalizes recording.
 
 // Important Variables:
 // - filename: Path for the output video file.
 // - frame_count: Tracks the number of encoded frames.
-// - output_file: File handle for writing raw frame data.
+// - output_file: File handle for writing raw frame data (open only while saving).
+// - width/height: Frame size of the current recording; frames of another size are rejected.
 
 // Inputs and Outputs:
-// - Inputs: output_path (const char*), data (unsigned char*), width (int), height (int).
+// - Inputs: output_path (const char*), data (unsigned char*), width (int), height (int), stride (int).
 // - Outputs: Return codes (int).
 
 typedef struct encoder encoder;
@@ -30,9 +35,21 @@ int encoder_init(encoder **enc, const char* output_path);
 // Clean up encoder resources
 int encoder_uninit(encoder *enc);
 
+// Start saving: open (truncate) the output file
+int encoder_start_saving(encoder *enc);
+
+// Stop saving: close the output file
+int encoder_stop_saving(encoder *enc);
+
+// Check if the encoder is currently saving
+int encoder_is_saving(encoder *enc);
+
 // Encode a frame (write raw data to file if saving)
 int encoder_encode_frame(encoder *enc, unsigned char *data, int width, int height);
 
+// Encode a strided view of a frame (stride = bytes between rows)
+int encoder_encode_view(encoder *enc, const unsigned char *data, int width, int height, int stride);
+
 // Finalize the recording (close the file)
 int encoder_finalize_recording(encoder *enc);
 
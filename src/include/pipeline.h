@@ -0,0 +1,86 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+// High-Level Explanation:
+// This module implements a declarative stage graph for the QNX video pipeline.
+// Modules register as stages with a typed frame input and output; stages are connected into a tree rooted at
+// source stages (such as camera capture), and each frame is pushed through the graph on a work-stealing thread pool.
+// Once a stage finishes, all of its downstream stages become runnable at the same time, so independent work on
+// the same frame (for example display conversion and encoding) runs in parallel across cores.
+// Important functions create the graph, register and connect stages, and run one frame through the graph.
+
+// Important Functions:
+// - pipeline_init: Creates an empty graph backed by a thread pool with a fixed number of workers.
+// - pipeline_uninit: Stops the thread pool and frees the graph.
+// - pipeline_add_stage: Registers a stage with its processing function and frame formats.
+// - pipeline_connect: Feeds the output of one stage into the input of another (formats must match).
+// - pipeline_process: Runs every source stage and its downstream stages once, blocking until all are done.
+//   Only a failing source stage fails the frame; any other failing stage just skips its downstream stages.
+// - pipeline_stage_count/pipeline_get_stage_stats: Report per-stage run counts and latency.
+
+// Important Variables:
+// - stages: Registered stages with their name, formats, upstream stage, and last output frame.
+// - pool: Work-stealing thread pool executing the stages.
+// - remaining: Stages still to complete for the frame in flight.
+
+// Inputs and Outputs:
+// - Inputs: name (const char*), process (int (*)), ctx (void*), input/output formats (pipeline_format).
+// - Outputs: Stage IDs (int), return codes (int).
+
+#define PIPELINE_MAX_STAGES 32
+
+typedef enum {
+    PIPELINE_FORMAT_NONE = 0, // No frame (input of source stages, output of sink stages)
+    PIPELINE_FORMAT_RGB888    // Packed 8-bit RGB, 3 bytes per pixel
+} pipeline_format;
+
+typedef struct {
+    unsigned char *data;
+    int width;
+    int height;
+    int stride;               // Bytes per row
+    pipeline_format format;
+    unsigned long sequence;   // Frame number assigned by pipeline_process
+} pipeline_frame;
+
+// Stage processing function: reads in (NULL for source stages) and fills out (ignored for sink stages).
+// Returns 0 on success; on failure the stage's downstream stages are skipped for this frame, and for a source stage
+// pipeline_process also returns -1.
+typedef int (*pipeline_stage_fn)(void *ctx, const pipeline_frame *in, pipeline_frame *out);
+
+// Per-stage timing accumulated over every processed frame
+typedef struct {
+    const char *name;
+    unsigned long runs;
+    unsigned long failures;   // Runs that returned an error (or produced no frame)
+    unsigned long long total_ns;
+    unsigned long long max_ns;
+} pipeline_stage_stats;
+
+typedef struct pipeline pipeline;
+
+// Create an empty graph running on num_threads workers (0 = number of online CPUs)
+int pipeline_init(pipeline **graph, int num_threads);
+
+// Stop the worker threads and free the graph
+int pipeline_uninit(pipeline *graph);
+
+// Register a stage (returns the stage ID, or -1 on error)
+int pipeline_add_stage(pipeline *graph, const char *name, pipeline_stage_fn process, void *ctx,
+                       pipeline_format input_format, pipeline_format output_format);
+
+// Look up a stage ID by name (returns -1 if not found)
+int pipeline_find_stage(pipeline *graph, const char *name);
+
+// Connect the output of stage 'from' to the input of stage 'to'
+int pipeline_connect(pipeline *graph, int from, int to);
+
+// Push one frame through the graph (blocks until every stage has run or been skipped; -1 if a source stage failed)
+int pipeline_process(pipeline *graph);
+
+// Number of registered stages
+int pipeline_stage_count(pipeline *graph);
+
+// Timing of stage 'id' (call between frames, not while pipeline_process is running)
+int pipeline_get_stage_stats(pipeline *graph, int id, pipeline_stage_stats *stats);
+
+#endif
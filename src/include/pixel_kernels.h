@@ -0,0 +1,56 @@
+#ifndef PIXEL_KERNELS_H
+#define PIXEL_KERNELS_H
+// High-Level Explanation:
+// This module provides the pixel kernels: blending (display status bar), nearest-neighbour row scaling (ROI zoom in the display),
+// and gain and row averaging, which have no pipeline caller yet and are only exercised by the bench and the self-check.
+// Every kernel is written once in pixel_kernels_impl.h and compiled into several ISA variants (scalar, SSE4, AVX2, NEON);
+// the best variant supported by the running CPU is selected once, at first use, and returned as a table of function pointers.
+// The kernels operate on bytes, so they apply to any 8-bit packed format such as RGB888 (the row scaler is RGB888 only).
+// Important functions return the selected kernel table, a specific variant, and run the variant self-check.
+
+// Important Functions:
+// - pixel_kernels_get: Returns the kernel table for the best variant (selected once, thread-safe).
+// - pixel_kernels_get_variant: Returns the table for a given ISA, or NULL if it is not built or not supported by the CPU.
+// - pixel_kernels_self_check: Compares every available variant against the scalar reference.
+
+// Important Variables:
+// - pixel_kernels: Table of kernel function pointers for one ISA variant.
+// - pixel_isa: Identifies an ISA variant.
+
+// Inputs and Outputs:
+// - Inputs: dst/src (unsigned char*), n (size_t bytes, or pixels for the row scaler), alpha (0..256), gain (Q8.8, 0..65535),
+//   x0/step (16.16 fixed-point source position of the first output pixel and per-pixel increment).
+// - Outputs: Kernel tables (const pixel_kernels*), return codes (int).
+
+#include <stddef.h>
+
+typedef enum {
+    PIXEL_ISA_SCALAR = 0,
+    PIXEL_ISA_SSE4,
+    PIXEL_ISA_AVX2,
+    PIXEL_ISA_NEON,
+    PIXEL_ISA_COUNT
+} pixel_isa;
+
+typedef struct {
+    const char *name;
+    // dst = (src * alpha + dst * (256 - alpha)) >> 8
+    void (*blend)(unsigned char *dst, const unsigned char *src, size_t n, int alpha);
+    // dst = min(255, (src * gain) >> 8); dst may equal src (bench/reference kernel, no pipeline caller yet)
+    void (*gain)(unsigned char *dst, const unsigned char *src, size_t n, int gain);
+    // dst = (a + b + 1) >> 1, e.g. to halve a frame vertically (bench/reference kernel, no pipeline caller yet)
+    void (*average_rows)(unsigned char *dst, const unsigned char *a, const unsigned char *b, size_t n);
+    // RGB888 pixel x of dst = pixel (x0 + x * step) >> 16 of src, for n output pixels; reads no source pixel past the last one sampled
+    void (*scale_row_nearest)(unsigned char *dst, const unsigned char *src, size_t n, unsigned int x0, unsigned int step);
+} pixel_kernels;
+
+// Get the best kernel variant for this CPU (selected on first call)
+const pixel_kernels *pixel_kernels_get(void);
+
+// Get a specific kernel variant (NULL if not built or not supported by this CPU)
+const pixel_kernels *pixel_kernels_get_variant(pixel_isa isa);
+
+// Compare every available variant against the scalar reference (0 if all match)
+int pixel_kernels_self_check(void);
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef RECORDING_H
+#define RECORDING_H
+// High-Level Explanation:
+// This module reads recordings saved by the video pipeline ('s' key: raw RGB888 frames written back to back) without loading them.
+// Frames are memory-mapped in windows of at most 64 MB starting at the requested frame or range, so seeking
+// to any frame is O(1) (index * frame size), only the pages actually touched are read, and recordings larger than the address
+// space (e.g. 10 GB on 32-bit targets) can be read.
+// Thumbnails and contact sheets are extracted in parallel on a thread pool, and frame ranges are exported straight from the mappings.
+// Important functions open/close a recording, access frames, export ranges, and produce thumbnails and contact sheets.
+
+// Important Functions:
+// - recording_open: Opens a recording of the given frame dimensions.
+// - recording_close: Unmaps any window and frees resources.
+// - recording_frame_count: Returns the number of complete frames in the file.
+// - recording_get_frame: Returns a pointer to a frame inside the current window (no copy).
+// - recording_export_range: Writes a range of frames to a new raw file.
+// - recording_extract_thumbnails: Writes downscaled PPM thumbnails of selected frames, in parallel.
+// - recording_contact_sheet: Tiles downscaled frames into one PPM image, in parallel.
+// - recording_write_ppm: Writes an RGB888 image as a binary PPM file.
+
+// Important Variables:
+// - window: Read-only mapping of the frames last returned by recording_get_frame.
+// - frame_size: Bytes per frame (width * height * 3).
+// - frame_count: Number of complete frames (a truncated last frame is ignored).
+
+// Inputs and Outputs:
+// - Inputs: path (const char*), width (int), height (int), frame ranges (int), scale factors (int), output paths (const char*).
+// - Outputs: Frame pointers (const unsigned char*), image files, return codes (int).
+
+typedef struct recording recording;
+
+// Open a recording made of raw RGB888 frames of width x height
+int recording_open(recording **rec, const char *path, int width, int height);
+
+// Unmap the recording and release resources
+int recording_close(recording *rec);
+
+// Number of complete frames in the recording
+int recording_frame_count(recording *rec);
+
+// Pointer to frame 'index' (NULL if out of range); valid until the next recording_get_frame or recording_close on rec
+const unsigned char *recording_get_frame(recording *rec, int index);
+
+// Write frames [first, first + count) to out_path as a raw recording
+int recording_export_range(recording *rec, int first, int count, const char *out_path);
+
+// Write 'count' thumbnails, one every 'step' frames from 'first', downscaled by 'scale', to out_dir/frame_NNNNNN.ppm
+int recording_extract_thumbnails(recording *rec, int first, int count, int step, int scale, const char *out_dir);
+
+// Tile 'count' frames (one every 'step' from 'first'), downscaled by 'scale', into a sheet with 'columns' columns
+int recording_contact_sheet(recording *rec, int first, int count, int step, int columns, int scale, const char *out_path);
+
+// Write an RGB888 image with the given row stride as a binary PPM (P6) file
+int recording_write_ppm(const char *path, const unsigned char *data, int width, int height, int stride);
+
+#endif
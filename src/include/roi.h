@@ -0,0 +1,59 @@
+#ifndef ROI_H
+#define ROI_H
+// High-Level Explanation:
+// This module provides region-of-interest (ROI) crops and digital zoom as zero-copy strided views of a frame.
+// A view points into the source frame's buffer with the source stride, so consumers (display, encoder) touch only the
+// ROI's pixels and their cost scales with the ROI area. Each consumer owns its own ROI controller, e.g. a zoomed
+// display next to a full-frame recording. Zoom changes are eased over several frames for smooth transitions, and
+// the nearest-neighbour scaler is only used by consumers whose output size differs from the ROI size.
+// Important functions create and configure ROI controllers, produce views, and scale views.
+
+// Important Functions:
+// - roi_init/roi_uninit: Create and free a per-consumer ROI controller (full frame by default).
+// - roi_set_rect: Targets an explicit crop rectangle.
+// - roi_set_zoom: Targets a zoom factor around a center point, keeping the frame's aspect ratio.
+// - roi_apply: Eases the current ROI one step toward its target and returns the corresponding view.
+// - roi_make_view: Builds a view of a rectangle of a frame (clamped to the frame).
+// - roi_scale_nearest: Scales a strided RGB888 image into another with nearest-neighbour sampling, one pixel kernel call per row.
+
+// Important Variables:
+// - current: ROI rectangle applied to the last frame (sub-pixel, for smooth zooming).
+// - target: Requested crop rectangle or zoom factor and center.
+
+// Inputs and Outputs:
+// - Inputs: rect (roi_rect*), zoom_percent (int), center (int), frame (pipeline_frame*).
+// - Outputs: view (pipeline_frame*), return codes (int).
+
+#include "pipeline.h"
+#include "pixel_kernels.h"
+
+typedef struct {
+    int x, y;
+    int width, height;
+} roi_rect;
+
+typedef struct roi roi;
+
+// Create a ROI controller covering the full frame
+int roi_init(roi **r);
+
+// Free a ROI controller
+int roi_uninit(roi *r);
+
+// Target an explicit crop rectangle (a zero-size rectangle selects the full frame)
+int roi_set_rect(roi *r, const roi_rect *rect);
+
+// Target a zoom of zoom_percent (100 = full frame) centered on (center_x, center_y) in frame pixels
+int roi_set_zoom(roi *r, int zoom_percent, int center_x, int center_y);
+
+// Step the ROI toward its target and return a zero-copy view of frame (thread-safe against the setters)
+int roi_apply(roi *r, const pipeline_frame *frame, pipeline_frame *view);
+
+// Build a zero-copy view of rect within frame (rect is clamped to the frame)
+int roi_make_view(const pipeline_frame *frame, const roi_rect *rect, pipeline_frame *view);
+
+// Scale a strided RGB888 image to dst_width x dst_height with nearest-neighbour sampling
+void roi_scale_nearest(const pixel_kernels *kernels, const unsigned char *src, int src_width, int src_height, int src_stride,
+                       unsigned char *dst, int dst_width, int dst_height, int dst_stride);
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+// High-Level Explanation:
+// This module captures full-resolution still snapshots without stalling the live pipeline.
+// A request only raises a counter; the next captured frame is held in its camera buffer (no copy) and queued to a
+// background worker, which compresses it to PNG and writes it out, then hands the buffer back to the camera.
+// The queue is bounded, so bursts of snapshots are absorbed up to its depth and further requests are dropped
+// instead of delaying frames.
+// Important functions initialize the worker, request snapshots, feed frames from the capture path, and clean up.
+
+// Important Functions:
+// - snapshot_init: Starts the snapshot worker writing into an output directory.
+// - snapshot_uninit: Finishes queued snapshots, stops the worker, and frees resources.
+// - snapshot_request: Asks for the next captured frame to be saved as a still.
+// - snapshot_capture: Called for every captured frame; queues it if a snapshot was requested (never blocks).
+
+// Important Variables:
+// - queue: Bounded ring of held frames waiting to be encoded.
+// - requested: Number of snapshots requested but not yet taken.
+// - output_dir: Directory for the PNG files (snapshot_<date>_<time>_<frame>.png, created exclusively so earlier stills are kept).
+
+// Inputs and Outputs:
+// - Inputs: camera (CameraWrapper*), output_dir (const char*), data (const unsigned char*), width (int), height (int).
+// - Outputs: PNG files, return codes (int).
+
+#include "camera_wrapper.h"
+
+#define SNAPSHOT_QUEUE_DEPTH 4
+
+typedef struct snapshot snapshot;
+
+// Start the snapshot worker; files are written to output_dir
+int snapshot_init(snapshot **snap, CameraWrapper *camera, const char *output_dir);
+
+// Encode any queued snapshots, stop the worker, and free resources
+int snapshot_uninit(snapshot *snap);
+
+// Request a snapshot of the next captured frame
+int snapshot_request(snapshot *snap);
+
+// Offer a captured RGB888 frame; queued without copying if a snapshot is pending (returns -1 if it had to be dropped)
+int snapshot_capture(snapshot *snap, const unsigned char *data, int width, int height, unsigned long sequence);
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef STAGES_H
+#define STAGES_H
+// High-Level Explanation:
+// This module defines the default topology of the QNX video pipeline as a stage graph.
+// Each module (camera, ISP, display, encoder) is wrapped in a small stage function and registered with the graph,
+// so the main loop only drives the graph and new stages are added here rather than in main.c.
+// Display and encoding both consume the ISP output and therefore run in parallel on the graph's thread pool.
+// The optional snapshot stage consumes the capture output directly, alongside the ISP.
+// Optional per-consumer ROI stages crop the ISP output into zero-copy views before display or encoding.
+
+// Important Functions:
+// - stages_register: Registers the capture, ISP, display, encode, and (if enabled) snapshot and ROI stages and connects them.
+
+// Important Variables:
+// - stages_context: Module handles shared by the stage functions.
+
+// Inputs and Outputs:
+// - Inputs: graph (pipeline*), ctx (stages_context*).
+// - Outputs: Return codes (int).
+
+#include "pipeline.h"
+#include "camera_wrapper.h"
+#include "isp.h"
+#include "display.h"
+#include "encoder.h"
+#include "roi.h"
+#include "snapshot.h"
+
+typedef struct {
+    CameraWrapper *camera;
+    isp *isp_camera;
+    display *screen;
+    encoder *recorder;
+    snapshot *snapshots; // Optional (NULL disables the snapshot stage)
+    roi *display_roi;    // Optional region shown on the display (NULL shows the full frame)
+    roi *record_roi;     // Optional region recorded by the encoder (NULL records the full frame); keep its size fixed while saving
+} stages_context;
+
+// Register the default stages (capture -> {isp -> {[roi ->] display, [roi ->] encode}, snapshot}) with the graph
+int stages_register(pipeline *graph, stages_context *ctx);
+
+#endif
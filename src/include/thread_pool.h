@@ -0,0 +1,40 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+// High-Level Explanation:
+// This module provides a fixed-size work-stealing thread pool used to run pipeline stages in parallel.
+// Each worker owns a task deque: it pushes and pops its own work at the bottom (LIFO, cache friendly) and,
+// when idle, steals from the top of another worker's deque (FIFO), so independent stages spread across cores.
+// Tasks submitted from outside the pool are distributed round-robin; tasks submitted by a running task go to
+// the submitting worker's own deque.
+// Important functions create the pool, submit tasks, and shut the pool down.
+
+// Important Functions:
+// - thread_pool_init: Starts a pool with a fixed number of workers (0 selects the number of online CPUs).
+// - thread_pool_uninit: Drains outstanding tasks, joins the workers, and frees the pool.
+// - thread_pool_submit: Queues a task for execution on one of the workers.
+// - thread_pool_size: Returns the number of workers in the pool.
+
+// Important Variables:
+// - workers: Per-worker state (thread ID and task deque).
+// - pending: Number of queued tasks not yet picked up, used to park idle workers.
+// - next_worker: Round-robin cursor for tasks submitted from outside the pool.
+
+// Inputs and Outputs:
+// - Inputs: num_threads (int), fn (void (*)(void *)), arg (void*).
+// - Outputs: Return codes (int).
+
+typedef struct thread_pool thread_pool;
+
+// Start a pool with num_threads workers (0 = number of online CPUs)
+int thread_pool_init(thread_pool **pool, int num_threads);
+
+// Run remaining tasks, stop the workers, and free the pool
+int thread_pool_uninit(thread_pool *pool);
+
+// Queue fn(arg) for execution on one of the workers
+int thread_pool_submit(thread_pool *pool, void (*fn)(void *), void *arg);
+
+// Number of workers in the pool
+int thread_pool_size(thread_pool *pool);
+
+#endif
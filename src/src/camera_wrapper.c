@@ -1,34 +1,45 @@
 // Created by Pouya Samandi on 2025-03-15.
 #include "camera_wrapper.h"
 #include <camera/camera.h> // Adjusted to QNX Camera Framework header
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#define NUM_BUFFERS 3
+#define NUM_BUFFERS 6
+#define MAX_HELD_FRAMES (NUM_BUFFERS - 2) // Always leave the camera two buffers to fill
 
 struct CameraQNX {
     camera_handle_t camera_handle; // QNX camera handle
     camera_buffer_t buffers[NUM_BUFFERS]; // Buffers for frames
     int width;
     int height;
-    int is_saving;              // Toggle state for saving
-    char* output_path;          // Path for saving video
-    FILE* output_file;          // File handle for saving raw frames
+    int current_index;          // Buffer returned by the last capture (-1 if none)
+    int holds[NUM_BUFFERS];     // Outstanding camera_hold_frame references per buffer
+    int total_holds;
+    pthread_mutex_t hold_mutex; // Protects current_index and holds
 };
 
-CameraWrapper* camera_init(int width, int height, const char* output_path) {
+// Find the buffer index owning a frame pointer (-1 if not a camera buffer)
+static int find_buffer(struct CameraQNX* cam, const unsigned char* data) {
+    for (int i = 0; i < NUM_BUFFERS; i++) {
+        if ((const unsigned char*)cam->buffers[i].data == data) return i;
+    }
+    return -1;
+}
+
+CameraWrapper* camera_init(int width, int height) {
     CameraWrapper* camera = (CameraWrapper*)malloc(sizeof(struct CameraQNX));
     if (!camera) return NULL;
 
-    // Store output path
-    ((struct CameraQNX*)camera)->output_path = strdup(output_path);
-    ((struct CameraQNX*)camera)->output_file = NULL; // Initialize file handle as NULL
-    ((struct CameraQNX*)camera)->is_saving = 0;     // Start with saving disabled
+    ((struct CameraQNX*)camera)->current_index = -1;
+    memset(((struct CameraQNX*)camera)->holds, 0, sizeof(((struct CameraQNX*)camera)->holds));
+    ((struct CameraQNX*)camera)->total_holds = 0;
+    pthread_mutex_init(&((struct CameraQNX*)camera)->hold_mutex, NULL);
 
     // Open QNX camera
     if (camera_open(CAMERA_UNIT_0, CAMERA_MODE_RW, &((struct CameraQNX*)camera)->camera_handle) != CAMERA_EOK) {
-        free(((struct CameraQNX*)camera)->output_path);
+        pthread_mutex_destroy(&((struct CameraQNX*)camera)->hold_mutex);
         free(camera);
         printf("Failed to open camera!\n");
         return NULL;
@@ -46,7 +57,7 @@ CameraWrapper* camera_init(int width, int height, const char* output_path) {
         if (!((struct CameraQNX*)camera)->buffers[i].data) {
             for (int j = 0; j < i; j++) free(((struct CameraQNX*)camera)->buffers[j].data);
             camera_close(((struct CameraQNX*)camera)->camera_handle);
-            free(((struct CameraQNX*)camera)->output_path);
+            pthread_mutex_destroy(&((struct CameraQNX*)camera)->hold_mutex);
             free(camera);
             return NULL;
         }
@@ -57,7 +68,7 @@ CameraWrapper* camera_init(int width, int height, const char* output_path) {
     if (camera_start(((struct CameraQNX*)camera)->camera_handle) != CAMERA_EOK) {
         for (int i = 0; i < NUM_BUFFERS; i++) free(((struct CameraQNX*)camera)->buffers[i].data);
         camera_close(((struct CameraQNX*)camera)->camera_handle);
-        free(((struct CameraQNX*)camera)->output_path);
+        pthread_mutex_destroy(&((struct CameraQNX*)camera)->hold_mutex);
         free(camera);
         printf("Failed to start camera!\n");
         return NULL;
@@ -69,6 +80,15 @@ CameraWrapper* camera_init(int width, int height, const char* output_path) {
 int camera_capture_frame(CameraWrapper* camera, unsigned char** data, int* width, int* height) {
     if (!camera || !((struct CameraQNX*)camera)->camera_handle) return -1;
 
+    // Hand the previous frame back to the camera unless someone still holds it
+    struct CameraQNX* cam = (struct CameraQNX*)camera;
+    pthread_mutex_lock(&cam->hold_mutex);
+    if (cam->current_index >= 0 && cam->holds[cam->current_index] == 0) {
+        camera_release_frame(cam->camera_handle, cam->current_index); // Hypothetical
+    }
+    cam->current_index = -1;
+    pthread_mutex_unlock(&cam->hold_mutex);
+
     // Capture a frame
     int idx = -1;
     if (camera_get_frame(((struct CameraQNX*)camera)->camera_handle, &((struct CameraQNX*)camera)->buffers[0], &idx, CAMERA_TIMEOUT_INFINITE) != CAMERA_EOK) {
@@ -80,49 +100,52 @@ int camera_capture_frame(CameraWrapper* camera, unsigned char** data, int* width
     *width = ((struct CameraQNX*)camera)->width;
     *height = ((struct CameraQNX*)camera)->height;
 
-    // Save raw frame data to file only if saving is enabled
-    if (((struct CameraQNX*)camera)->is_saving && ((struct CameraQNX*)camera)->output_file) {
-        size_t frame_size = ((struct CameraQNX*)camera)->width * ((struct CameraQNX*)camera)->height * 3;
-        fwrite(*data, 1, frame_size, ((struct CameraQNX*)camera)->output_file);
-    }
-
-    // Release the frame for reuse
-    camera_release_frame(((struct CameraQNX*)camera)->camera_handle, idx); // Hypothetical
+    // Keep the frame until the next capture so downstream stages and holders can use it without copying
+    pthread_mutex_lock(&cam->hold_mutex);
+    cam->current_index = idx;
+    pthread_mutex_unlock(&cam->hold_mutex);
 
     return 0;
 }
 
-int camera_start_saving(CameraWrapper* camera) {
-    if (!camera) return -1;
+int camera_hold_frame(CameraWrapper* camera, const unsigned char* data) {
+    if (!camera || !data) return -1;
     struct CameraQNX* cam = (struct CameraQNX*)camera;
-    if (cam->is_saving) return -1; // Already saving, do nothing
-    cam->output_file = fopen(cam->output_path, "wb");
-    if (!cam->output_file) {
-        printf("Failed to open output file: %s\n", cam->output_path);
+    int idx = find_buffer(cam, data);
+    if (idx < 0) return -1;
+
+    pthread_mutex_lock(&cam->hold_mutex);
+    if (cam->total_holds >= MAX_HELD_FRAMES) {
+        pthread_mutex_unlock(&cam->hold_mutex);
         return -1;
     }
-    cam->is_saving = 1;
+    cam->holds[idx]++;
+    cam->total_holds++;
+    pthread_mutex_unlock(&cam->hold_mutex);
     return 0;
 }
 
-int camera_stop_saving(CameraWrapper* camera) {
-    if (!camera) return -1;
+int camera_release_held_frame(CameraWrapper* camera, const unsigned char* data) {
+    if (!camera || !data) return -1;
     struct CameraQNX* cam = (struct CameraQNX*)camera;
-    if (!cam->is_saving) return -1; // Not saving, do nothing
-    if (cam->output_file) {
-        fclose(cam->output_file);
-        cam->output_file = NULL;
+    int idx = find_buffer(cam, data);
+    if (idx < 0) return -1;
+
+    pthread_mutex_lock(&cam->hold_mutex);
+    if (cam->holds[idx] == 0) {
+        pthread_mutex_unlock(&cam->hold_mutex);
+        return -1;
     }
-    cam->is_saving = 0;
+    cam->holds[idx]--;
+    cam->total_holds--;
+    // The current frame is handed back by the next capture; older frames go back as soon as the last hold ends
+    if (cam->holds[idx] == 0 && idx != cam->current_index) {
+        camera_release_frame(cam->camera_handle, idx); // Hypothetical
+    }
+    pthread_mutex_unlock(&cam->hold_mutex);
     return 0;
 }
 
-int camera_is_saving(CameraWrapper* camera) {
-    if (!camera) return 0;
-    struct CameraQNX* cam = (struct CameraQNX*)camera;
-    return cam->is_saving;
-}
-
 void camera_release(CameraWrapper* camera) {
     if (camera) {
         struct CameraQNX* cam = (struct CameraQNX*)camera;
@@ -134,8 +157,7 @@ void camera_release(CameraWrapper* camera) {
         for (int i = 0; i < NUM_BUFFERS; i++) {
             free(cam->buffers[i].data);
         }
-        if (cam->output_file) fclose(cam->output_file);
-        free(cam->output_path);
+        pthread_mutex_destroy(&cam->hold_mutex);
         free(camera);
     }
 }
\ No newline at end of file
@@ -1,10 +1,15 @@
 // Created by Pouya Samandi on 2025-03-15.
 #include "display.h"
+#include "pixel_kernels.h"
+#include "roi.h"
 #include <screen/screen.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#define STATUS_BAR_HEIGHT 32
+#define STATUS_BAR_ALPHA 96 // Out of 256
+
 // Helper structure to store display state
 typedef struct {
     void (*callback)(void);
@@ -13,8 +18,20 @@ typedef struct {
     screen_window_t screen_win;
     screen_buffer_t screen_buf;
     int width, height;
+    int out_width, out_height; // Requested window size (0: follow the frame size)
+    const pixel_kernels *kernels;
+    unsigned char *status_rows[2]; // One row of the status bar color (0: not saving, 1: saving)
 } display_t;
 
+// Fill a row of RGB888 pixels with a 0xRRGGBB color
+static void fill_row(unsigned char *row, int width, int color) {
+    for (int x = 0; x < width; x++) {
+        row[x * 3] = (unsigned char)(color >> 16);
+        row[x * 3 + 1] = (unsigned char)(color >> 8);
+        row[x * 3 + 2] = (unsigned char)color;
+    }
+}
+
 // Helper function to draw text (simplified placeholder, replace with actual QNX text rendering if available)
 void draw_text(screen_window_t win, const char* text, int x, int y, int color) {
     // Placeholder: QNX Screen API doesn't natively support text rendering
@@ -28,6 +45,14 @@ int display_init(display **disp, void (*display_callback)(void)) {
 
     new_display->callback = display_callback;
     new_display->is_initialized = 1;
+    new_display->screen_buf = NULL;
+    new_display->width = 0;
+    new_display->height = 0;
+    new_display->out_width = 0;
+    new_display->out_height = 0;
+    new_display->kernels = pixel_kernels_get();
+    new_display->status_rows[0] = NULL;
+    new_display->status_rows[1] = NULL;
 
     // Create screen context
     if (screen_create_context(&new_display->screen_ctx, SCREEN_APPLICATION_CONTEXT) != 0) {
@@ -57,6 +82,8 @@ int display_uninit(display *disp) {
     display_t *d = (display_t *)disp;
 
     if (d->screen_buf) screen_destroy_buffer(d->screen_buf);
+    free(d->status_rows[0]);
+    free(d->status_rows[1]);
     screen_destroy_window(d->screen_win);
     screen_destroy_context(d->screen_ctx);
     d->is_initialized = 0;
@@ -64,11 +91,27 @@ int display_uninit(display *disp) {
     return 0;
 }
 
+int display_set_output_size(display *disp, int width, int height) {
+    if (!disp || width < 0 || height < 0) return -1;
+    display_t *d = (display_t *)disp;
+    d->out_width = width;
+    d->out_height = height;
+    return 0;
+}
+
 int display_display_data(display *disp, unsigned char *data, int width, int height, int is_saving) {
+    return display_display_view(disp, data, width, height, width * 3, is_saving); // Assuming RGB888 format
+}
+
+int display_display_view(display *disp, const unsigned char *data, int view_width, int view_height, int stride, int is_saving) {
     if (!disp || !data) return -1;
     display_t *d = (display_t *)disp;
     if (d->is_initialized == 0) return -1;
 
+    // The window follows the view unless a fixed output size was requested
+    int width = d->out_width > 0 ? d->out_width : view_width;
+    int height = d->out_height > 0 ? d->out_height : view_height;
+
     // Update window dimensions if needed
     if (d->width != width || d->height != height) {
         d->width = width;
@@ -80,16 +123,39 @@ int display_display_data(display *disp, unsigned char *data, int width, int heig
         if (d->screen_buf) screen_destroy_buffer(d->screen_buf);
         screen_create_window_buffers(d->screen_win, 1);
         screen_get_window_property_pv(d->screen_win, SCREEN_PROPERTY_RENDER_BUFFERS, (void**)&d->screen_buf);
+
+        // Rebuild the status bar color rows for the new width
+        for (int i = 0; i < 2; i++) {
+            free(d->status_rows[i]);
+            d->status_rows[i] = (unsigned char *)malloc(width * 3);
+            if (d->status_rows[i]) fill_row(d->status_rows[i], width, i ? 0x00FF00 : 0xFF0000);
+        }
     }
 
-    // Copy data to the screen buffer
+    // Copy data to the screen buffer, scaling only when the view and window sizes differ
     void *ptr;
     screen_get_buffer_property_pv(d->screen_buf, SCREEN_PROPERTY_POINTER, &ptr);
-    memcpy(ptr, data, width * height * 3); // Assuming RGB888 format
+    size_t row_size = (size_t)width * 3; // Assuming RGB888 format
+    if (view_width != width || view_height != height) {
+        roi_scale_nearest(d->kernels, data, view_width, view_height, stride, (unsigned char *)ptr, width, height, (int)row_size);
+    } else if (stride == (int)row_size) {
+        memcpy(ptr, data, row_size * height);
+    } else {
+        for (int y = 0; y < height; y++) {
+            memcpy((unsigned char *)ptr + y * row_size, data + (size_t)y * stride, row_size);
+        }
+    }
 
-    // Overlay saving status text
+    // Overlay saving status bar and text
     const char *status_text = is_saving ? "Saving Video" : "Not Saving";
     int color = is_saving ? 0x00FF00 : 0xFF0000; // Green for saving, Red for not saving
+    const unsigned char *bar = d->status_rows[is_saving ? 1 : 0];
+    if (bar) {
+        int bar_height = height < STATUS_BAR_HEIGHT ? height : STATUS_BAR_HEIGHT;
+        for (int y = 0; y < bar_height; y++) {
+            d->kernels->blend((unsigned char *)ptr + (size_t)y * width * 3, bar, (size_t)width * 3, STATUS_BAR_ALPHA);
+        }
+    }
     draw_text(d->screen_win, status_text, 10, 20, color); // Placeholder text rendering
 
     // Post the buffer to the window
@@ -117,9 +183,11 @@ int display_get_keypress(void) {
             // Map QNX key codes to ASCII (simplified)
             if (key == 0x73) key = 's'; // 's' key
             else if (key == 0x71) key = 'q'; // 'q' key
+            else if (key == 0x70) key = 'p'; // 'p' key
+            else if (key == 0x7A) key = 'z'; // 'z' key
         }
     }
 
     screen_destroy_event(event);
-    return key; // Return -1 if no keypress, or 's'/'q' if detected
+    return key; // Return -1 if no keypress, or 's'/'p'/'z'/'q' if detected
 }
\ No newline at end of file
@@ -8,7 +8,8 @@ typedef struct {
     char *filename;
     int is_initialized;
     int frame_count;
-    FILE* output_file; // File handle for saving raw frames
+    FILE* output_file; // File handle for saving raw frames (open while saving)
+    int width, height; // Size of the recorded frames, fixed by the first frame after saving starts
 } encoder_t;
 
 int encoder_init(encoder **enc, const char* output_path) {
@@ -19,6 +20,8 @@ int encoder_init(encoder **enc, const char* output_path) {
     new_encoder->is_initialized = 1;
     new_encoder->frame_count = 0;
     new_encoder->output_file = NULL; // Initialize file handle as NULL
+    new_encoder->width = 0;
+    new_encoder->height = 0;
     *enc = (encoder *)new_encoder;
     return 0;
 }
@@ -33,21 +36,73 @@ int encoder_uninit(encoder *enc) {
     return 0;
 }
 
+int encoder_start_saving(encoder *enc) {
+    if (enc == NULL) return -1;
+    encoder_t *e = (encoder_t *)enc;
+    if (e->is_initialized == 0 || e->output_file) return -1; // Already saving, do nothing
+    e->output_file = fopen(e->filename, "wb");
+    if (!e->output_file) {
+        printf("Failed to open output file: %s\n", e->filename);
+        return -1;
+    }
+    e->frame_count = 0;
+    e->width = 0;
+    e->height = 0;
+    return 0;
+}
+
+int encoder_stop_saving(encoder *enc) {
+    if (enc == NULL) return -1;
+    encoder_t *e = (encoder_t *)enc;
+    if (!e->output_file) return -1; // Not saving, do nothing
+    int result = fclose(e->output_file) == 0 ? 0 : -1;
+    e->output_file = NULL;
+    if (result != 0) printf("Error closing %s\n", e->filename);
+    return result;
+}
+
+int encoder_is_saving(encoder *enc) {
+    if (enc == NULL) return 0;
+    return ((encoder_t *)enc)->output_file != NULL;
+}
+
 int encoder_encode_frame(encoder *enc, unsigned char *data, int width, int height) {
+    return encoder_encode_view(enc, data, width, height, width * 3); // Assuming RGB888 format
+}
+
+int encoder_encode_view(encoder *enc, const unsigned char *data, int width, int height, int stride) {
     if (enc == NULL || data == NULL) return -1;
     encoder_t *e = (encoder_t *)enc;
     if (e->is_initialized == 0) return -1;
 
-    e->frame_count++;
-    printf("Encoding frame %d...\n", e->frame_count);
-
     // Write raw frame data to file only if output_file is open
     if (e->output_file) {
-        size_t frame_size = width * height * 3; // Assuming RGB888 format
-        if (fwrite(data, 1, frame_size, e->output_file) != frame_size) {
-            printf("Error writing frame %d to %s\n", e->frame_count, e->filename);
+        // A raw recording has no per-frame header, so every frame must have the size of the first one
+        if (e->frame_count == 0) {
+            e->width = width;
+            e->height = height;
+        } else if (width != e->width || height != e->height) {
+            printf("Frame size %dx%d differs from the recording (%dx%d), frame not written\n", width, height, e->width, e->height);
             return -1;
         }
+        e->frame_count++;
+        printf("Encoding frame %d...\n", e->frame_count);
+
+        size_t row_size = (size_t)width * 3; // Assuming RGB888 format
+        if (stride == (int)row_size) {
+            // Packed rows: write the whole frame at once
+            if (fwrite(data, 1, row_size * height, e->output_file) != row_size * height) {
+                printf("Error writing frame %d to %s\n", e->frame_count, e->filename);
+                return -1;
+            }
+        } else {
+            for (int y = 0; y < height; y++) {
+                if (fwrite(data + (size_t)y * stride, 1, row_size, e->output_file) != row_size) {
+                    printf("Error writing frame %d to %s\n", e->frame_count, e->filename);
+                    return -1;
+                }
+            }
+        }
     }
 
     return 0;
@@ -8,7 +8,7 @@ typedef struct {
     unsigned char *r0_data;
     unsigned char *r1_data;
     int r0_width, r0_height;
-    int r1_width, int r1_height;
+    int r1_width, r1_height;
     int current_buffer; // 0 for R0, 1 for R1
 } isp_t;
 
@@ -1,24 +1,22 @@
 // High-Level Explanation:
 // This module is the main entry point for the QNX-based video pipeline, integrating camera, display, encoder, and ISP modules to capture, process, and save video.
-// It initializes all components, runs a loop to capture and display frames, handles user keypresses ('s' to toggle saving, 'q' to quit), and manages a multi-threaded encoding process.
-// The pipeline captures frames using the QNX Camera Framework, displays them using the QNX Screen API, and saves raw frames to a file when saving is active.
-// Important functions include the main loop, ISP callback for frame processing, and the encoder thread for parallel encoding.
-// Key variables include global pointers to modules, mutexes for thread safety, the encoding state, and the output file path.
+// It initializes all components, builds the stage graph (capture -> ISP -> display/encode), and runs a loop that pushes one frame at a time through the graph while handling user keypresses ('s' to toggle saving, 'p' for a still snapshot, 'z' to cycle display zoom, 'q' to quit).
+// The graph runs on a work-stealing thread pool, so display and encoding of the same frame proceed in parallel without a dedicated encoder thread.
+// Important functions include the main loop and the display callback; the stage functions live in stages.c.
+// Key variables include the module handles, the stage graph, and the output file path.
 
 // Important Functions:
-// - isp_callback: Retrieves the current buffer from the ISP and displays it with the saving status.
 // - display_callback: Placeholder for post-display processing (currently empty).
-// - encoder_thread: Runs in a separate thread to capture and encode frames when saving is active.
-// - main: Initializes modules, runs the main loop, processes keypresses, and handles cleanup.
+// - main: Initializes modules, builds the stage graph, runs the main loop, processes keypresses, and handles cleanup.
 
 // Important Variables:
-// - global_display: Pointer to the display module for rendering frames.
-// - global_encoder: Pointer to the encoder module for saving frames.
-// - camera: Pointer to the camera wrapper for capturing frames.
-// - is_encoding: Flag to control the encoder thread.
-// - encoder_thread_id: POSIX thread ID for the encoder thread.
-// - camera_mutex/encode_mutex: Mutexes for thread synchronization.
+// - stage_ctx: Module handles shared with the pipeline stages.
+// - graph: Stage graph driving capture, ISP, display, encoding, and snapshots.
+// - stills: Snapshot worker encoding requested stills to PNG in the background.
+// - display_roi: Region of interest shown on the display (digital zoom); the recording keeps the full frame.
+// - zoom_levels/zoom_index: Display zoom steps cycled with 'z'.
 // - output_path: Path for the output video file.
+// - output_dir: Directory for the video file and snapshots.
 
 // Inputs and Outputs:
 // - Inputs: None (configured via constants like width/height and output path).
@@ -28,69 +26,32 @@
 #include "display.h"
 #include "encoder.h"
 #include "camera_wrapper.h"
+#include "pipeline.h"
+#include "snapshot.h"
+#include "stages.h"
 #include <stdio.h>
-#include <pthread.h>
 #include <unistd.h>
 #include <string.h>
 #include <limits.h>
 
-display *global_display;
-encoder *global_encoder;
-CameraWrapper *camera; // Updated to CameraWrapper
-int is_encoding = 0;
-pthread_t encoder_thread_id;
-pthread_mutex_t camera_mutex = PTHREAD_MUTEX_INITIALIZER;
-pthread_mutex_t encode_mutex = PTHREAD_MUTEX_INITIALIZER;
-
-void isp_callback(struct isp *isp_camera) {
-    int width, height;
-    unsigned char *data = isp_get_current_buffer(isp_camera, &width, &height);
-    if (data) {
-        display_display_data(global_display, data, width, height, camera_is_saving(camera));
-    }
-}
+#define FRAME_WIDTH 1280
+#define FRAME_HEIGHT 720
+
+static const int zoom_levels[] = { 100, 200, 400 }; // Percent
 
 void display_callback(void) {
     // Optional: Add debug logging or additional display-related callbacks if needed
 }
 
-void *encoder_thread(void *arg) {
-    while (1) {
-        pthread_mutex_lock(&camera_mutex);
-        pthread_mutex_lock(&encode_mutex);
-        if (!is_encoding) {
-            pthread_mutex_unlock(&encode_mutex);
-            pthread_mutex_unlock(&camera_mutex);
-            printf("Encoder thread exiting...\n");
-            break;
-        }
-        pthread_mutex_unlock(&encode_mutex);
-
-        int width, height;
-        unsigned char *data;
-        if (camera_capture_frame(camera, &data, &width, &height) != 0) {
-            printf("Failed to capture frame for encoding!\n");
-            pthread_mutex_unlock(&camera_mutex);
-            break;
-        }
-        pthread_mutex_unlock(&camera_mutex);
-
-        // Encode frame only if saving is enabled
-        if (camera_is_saving(camera)) {
-            if (encoder_encode_frame(global_encoder, data, width, height) != 0) {
-                printf("Failed to encode frame!\n");
-            }
-        }
-
-        usleep(10000); // Small delay to prevent overwhelming the thread
-    }
-    return NULL;
-}
-
 int main() {
+    CameraWrapper *camera;
     isp *isp_camera;
     display *screen;
     encoder *recorder;
+    snapshot *stills;
+    roi *display_roi;
+    pipeline *graph;
+    int zoom_index = 0;
 
     // Get the current working directory
     char cwd[PATH_MAX];
@@ -100,19 +61,21 @@ int main() {
     }
 
     // Construct the full path for the output video file in the output directory
+    char output_dir[PATH_MAX];
     char output_path[PATH_MAX];
-    snprintf(output_path, sizeof(output_path), "%s/../output/output_video.mp4", cwd);
+    snprintf(output_dir, sizeof(output_dir), "%s/../output", cwd);
+    snprintf(output_path, sizeof(output_path), "%s/output_video.mp4", output_dir);
 
-    // Initialize camera with the full path
-    camera = camera_init(1280, 720, output_path);
+    // Initialize camera
+    camera = camera_init(FRAME_WIDTH, FRAME_HEIGHT);
     if (!camera) {
         printf("Failed to initialize camera!\n");
         return 1;
     }
     printf("Camera initialized.\n");
 
-    // Initialize ISP
-    if (isp_init(&isp_camera, isp_callback) != 0) {
+    // Initialize ISP (frames are pulled by the ISP stage, so no callback is needed)
+    if (isp_init(&isp_camera, NULL) != 0) {
         printf("ISP init failed!\n");
         camera_release(camera);
         return 1;
@@ -137,67 +100,96 @@ int main() {
         return 1;
     }
     printf("Encoder initialized.\n");
-    global_display = screen;
-    global_encoder = recorder;
-
-    // Start encoder thread
-    pthread_mutex_lock(&encode_mutex);
-    is_encoding = 1;
-    if (pthread_create(&encoder_thread_id, NULL, encoder_thread, NULL) != 0) {
-        printf("Encoder thread creation failed!\n");
-        pthread_mutex_unlock(&encode_mutex);
+
+    // Initialize snapshot worker
+    if (snapshot_init(&stills, camera, output_dir) != 0) {
+        printf("Snapshot init failed!\n");
         encoder_uninit(recorder);
         display_uninit(screen);
         isp_uninit(isp_camera);
         camera_release(camera);
         return 1;
     }
-    pthread_mutex_unlock(&encode_mutex);
-    printf("Press 's' to toggle saving, 'q' to quit.\n");
+    printf("Snapshot worker initialized.\n");
 
-    // Main loop: Capture and process frames until 'q' is pressed
+    // Zoomed views are scaled to a fixed window; the recording is not cropped
+    if (roi_init(&display_roi) != 0) {
+        printf("ROI init failed!\n");
+        snapshot_uninit(stills);
+        encoder_uninit(recorder);
+        display_uninit(screen);
+        isp_uninit(isp_camera);
+        camera_release(camera);
+        return 1;
+    }
+    display_set_output_size(screen, FRAME_WIDTH, FRAME_HEIGHT);
+
+    // Build the stage graph on a pool with one worker per CPU
+    stages_context stage_ctx = { camera, isp_camera, screen, recorder, stills, display_roi, NULL };
+    if (pipeline_init(&graph, 0) != 0) {
+        printf("Pipeline init failed!\n");
+        roi_uninit(display_roi);
+        snapshot_uninit(stills);
+        encoder_uninit(recorder);
+        display_uninit(screen);
+        isp_uninit(isp_camera);
+        camera_release(camera);
+        return 1;
+    }
+    if (stages_register(graph, &stage_ctx) != 0) {
+        printf("Pipeline stage registration failed!\n");
+        pipeline_uninit(graph);
+        roi_uninit(display_roi);
+        snapshot_uninit(stills);
+        encoder_uninit(recorder);
+        display_uninit(screen);
+        isp_uninit(isp_camera);
+        camera_release(camera);
+        return 1;
+    }
+    printf("Pipeline initialized.\n");
+    printf("Press 's' to toggle saving, 'p' for a snapshot, 'z' to zoom, 'q' to quit.\n");
+
+    // Main loop: Push frames through the graph until 'q' is pressed
     while (1) {
-        int width, height;
-        unsigned char *data;
-        pthread_mutex_lock(&camera_mutex);
-        if (camera_capture_frame(camera, &data, &width, &height) != 0) {
-            printf("Failed to capture frame!\n");
-            pthread_mutex_unlock(&camera_mutex);
+        // Only a capture failure is fatal; display and encode errors are logged by their stages and the loop goes on
+        if (pipeline_process(graph) != 0) {
+            printf("Pipeline failed to capture frame!\n");
             break;
         }
-        pthread_mutex_unlock(&camera_mutex);
-
-        isp_program_R0(isp_camera, data, width, height);
-        isp_program_R1(isp_camera, data, width, height); // Same frame for simplicity
-        isp_start(isp_camera);
 
         // Handle keypresses
         int key = display_get_keypress();
         if (key == 's') {
-            if (!camera_is_saving(camera)) {
-                if (camera_start_saving(camera) == 0) {
+            if (!encoder_is_saving(recorder)) {
+                if (encoder_start_saving(recorder) == 0) {
                     printf("Started saving video to %s\n", output_path);
                 } else {
                     printf("Failed to start saving video!\n");
                 }
             } else {
-                camera_stop_saving(camera);
+                encoder_stop_saving(recorder);
                 printf("Stopped saving video.\n");
             }
+        } else if (key == 'p') {
+            snapshot_request(stills);
+        } else if (key == 'z') {
+            zoom_index = (zoom_index + 1) % (int)(sizeof(zoom_levels) / sizeof(zoom_levels[0]));
+            roi_set_zoom(display_roi, zoom_levels[zoom_index], FRAME_WIDTH / 2, FRAME_HEIGHT / 2);
+            printf("Display zoom %d%%\n", zoom_levels[zoom_index]);
         } else if (key == 'q') {
-            if (camera_is_saving(camera)) {
-                camera_stop_saving(camera);
+            if (encoder_is_saving(recorder)) {
+                encoder_stop_saving(recorder);
                 printf("Stopped saving video.\n");
             }
-            pthread_mutex_lock(&encode_mutex);
-            is_encoding = 0;
-            pthread_mutex_unlock(&encode_mutex);
             break;
         }
     }
 
-    // Stop encoding
-    pthread_join(encoder_thread_id, NULL);
+    // Stop encoding and finish queued snapshots
+    pipeline_uninit(graph);
+    snapshot_uninit(stills);
+    roi_uninit(display_roi);
     encoder_finalize_recording(recorder);
     printf("Saving stopped and file finalized.\n");
 
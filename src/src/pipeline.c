@@ -0,0 +1,234 @@
+#include "pipeline.h"
+#include "thread_pool.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+struct pipeline_s;
+
+typedef struct {
+    char *name;
+    pipeline_stage_fn process;
+    void *ctx;
+    pipeline_format input_format;
+    pipeline_format output_format;
+    int upstream;                         // Stage feeding this one (-1 if none)
+    int children[PIPELINE_MAX_STAGES];    // Stages fed by this one
+    int num_children;
+    pipeline_frame output;                // Output of the frame in flight
+    pipeline_stage_stats stats;
+    struct pipeline_s *graph;             // Back pointer used by the stage task
+} pipeline_stage;
+
+typedef struct pipeline_s {
+    thread_pool *pool;
+    pipeline_stage stages[PIPELINE_MAX_STAGES];
+    int num_stages;
+    pthread_mutex_t lock;
+    pthread_cond_t done_cond;
+    int remaining;            // Stages not yet completed or skipped for the frame in flight
+    int failed;               // Set if a source stage failed for the frame in flight
+    unsigned long sequence;
+} pipeline_t;
+
+static const char *format_name(pipeline_format format) {
+    switch (format) {
+        case PIPELINE_FORMAT_NONE: return "none";
+        case PIPELINE_FORMAT_RGB888: return "RGB888";
+    }
+    return "unknown";
+}
+
+static unsigned long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ull + (unsigned long long)ts.tv_nsec;
+}
+
+static int subtree_size(pipeline_t *g, int id) {
+    int size = 1;
+    for (int i = 0; i < g->stages[id].num_children; i++) {
+        size += subtree_size(g, g->stages[id].children[i]);
+    }
+    return size;
+}
+
+static void complete_stages(pipeline_t *g, int count, int failed) {
+    pthread_mutex_lock(&g->lock);
+    g->remaining -= count;
+    if (failed) g->failed = 1;
+    if (g->remaining == 0) pthread_cond_broadcast(&g->done_cond);
+    pthread_mutex_unlock(&g->lock);
+}
+
+static void run_stage(void *arg) {
+    pipeline_stage *stage = (pipeline_stage *)arg;
+    pipeline_t *g = stage->graph;
+    const pipeline_frame *in = stage->upstream >= 0 ? &g->stages[stage->upstream].output : NULL;
+
+    memset(&stage->output, 0, sizeof(stage->output));
+    stage->output.format = stage->output_format;
+    stage->output.sequence = in ? in->sequence : g->sequence;
+
+    unsigned long long start = now_ns();
+    int ok = stage->process(stage->ctx, in, &stage->output) == 0;
+    unsigned long long elapsed = now_ns() - start;
+    stage->stats.runs++;
+    stage->stats.total_ns += elapsed;
+    if (elapsed > stage->stats.max_ns) stage->stats.max_ns = elapsed;
+    if (ok && stage->output_format != PIPELINE_FORMAT_NONE && stage->output.data == NULL) {
+        printf("Stage %s produced no frame!\n", stage->name);
+        ok = 0;
+    }
+    if (!ok) stage->stats.failures++;
+
+    // Fan out: every downstream stage becomes runnable at once
+    int skipped = 0;
+    for (int i = 0; i < stage->num_children; i++) {
+        int child = stage->children[i];
+        if (!ok || thread_pool_submit(g->pool, run_stage, &g->stages[child]) != 0) {
+            skipped += subtree_size(g, child);
+        }
+    }
+    // Without a source frame nothing can run, so only source failures fail the frame; other stages drop this frame
+    complete_stages(g, 1 + skipped, !ok && stage->upstream < 0);
+}
+
+int pipeline_init(pipeline **graph, int num_threads) {
+    if (graph == NULL) return -1;
+    pipeline_t *new_graph = (pipeline_t *)calloc(1, sizeof(pipeline_t));
+    if (!new_graph) return -1;
+    if (thread_pool_init(&new_graph->pool, num_threads) != 0) {
+        free(new_graph);
+        return -1;
+    }
+    pthread_mutex_init(&new_graph->lock, NULL);
+    pthread_cond_init(&new_graph->done_cond, NULL);
+    *graph = (pipeline *)new_graph;
+    return 0;
+}
+
+int pipeline_uninit(pipeline *graph) {
+    if (!graph) return -1;
+    pipeline_t *g = (pipeline_t *)graph;
+    thread_pool_uninit(g->pool);
+    for (int i = 0; i < g->num_stages; i++) {
+        free(g->stages[i].name);
+    }
+    pthread_cond_destroy(&g->done_cond);
+    pthread_mutex_destroy(&g->lock);
+    free(g);
+    return 0;
+}
+
+int pipeline_add_stage(pipeline *graph, const char *name, pipeline_stage_fn process, void *ctx,
+                       pipeline_format input_format, pipeline_format output_format) {
+    if (!graph || !name || !process) return -1;
+    pipeline_t *g = (pipeline_t *)graph;
+    if (g->num_stages == PIPELINE_MAX_STAGES) {
+        printf("Pipeline is full, cannot add stage %s\n", name);
+        return -1;
+    }
+    if (pipeline_find_stage(graph, name) >= 0) {
+        printf("Pipeline stage %s already exists\n", name);
+        return -1;
+    }
+
+    int id = g->num_stages;
+    pipeline_stage *stage = &g->stages[id];
+    memset(stage, 0, sizeof(*stage));
+    stage->name = strdup(name);
+    if (!stage->name) return -1;
+    stage->process = process;
+    stage->ctx = ctx;
+    stage->input_format = input_format;
+    stage->output_format = output_format;
+    stage->upstream = -1;
+    stage->graph = g;
+    stage->stats.name = stage->name;
+    g->num_stages++;
+    return id;
+}
+
+int pipeline_find_stage(pipeline *graph, const char *name) {
+    if (!graph || !name) return -1;
+    pipeline_t *g = (pipeline_t *)graph;
+    for (int i = 0; i < g->num_stages; i++) {
+        if (strcmp(g->stages[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+int pipeline_connect(pipeline *graph, int from, int to) {
+    if (!graph) return -1;
+    pipeline_t *g = (pipeline_t *)graph;
+    if (from < 0 || from >= g->num_stages || to < 0 || to >= g->num_stages || from == to) return -1;
+    pipeline_stage *src = &g->stages[from];
+    pipeline_stage *dst = &g->stages[to];
+
+    if (dst->upstream >= 0) {
+        printf("Stage %s already has an input\n", dst->name);
+        return -1;
+    }
+    if (src->output_format == PIPELINE_FORMAT_NONE || src->output_format != dst->input_format) {
+        printf("Cannot connect %s (%s) to %s (%s)\n", src->name, format_name(src->output_format),
+               dst->name, format_name(dst->input_format));
+        return -1;
+    }
+    // Reject cycles: 'to' must not already feed 'from'
+    for (int s = from; s >= 0; s = g->stages[s].upstream) {
+        if (s == to) {
+            printf("Connecting %s to %s would create a cycle\n", src->name, dst->name);
+            return -1;
+        }
+    }
+
+    src->children[src->num_children++] = to;
+    dst->upstream = from;
+    return 0;
+}
+
+int pipeline_process(pipeline *graph) {
+    if (!graph) return -1;
+    pipeline_t *g = (pipeline_t *)graph;
+    if (g->num_stages == 0) return -1;
+
+    pthread_mutex_lock(&g->lock);
+    g->remaining = g->num_stages;
+    g->failed = 0;
+    g->sequence++;
+    pthread_mutex_unlock(&g->lock);
+
+    // Start every source; stages that need an input but were never connected are skipped
+    for (int i = 0; i < g->num_stages; i++) {
+        pipeline_stage *stage = &g->stages[i];
+        if (stage->upstream >= 0) continue;
+        if (stage->input_format != PIPELINE_FORMAT_NONE ||
+            thread_pool_submit(g->pool, run_stage, stage) != 0) {
+            complete_stages(g, subtree_size(g, i), 0);
+        }
+    }
+
+    pthread_mutex_lock(&g->lock);
+    while (g->remaining > 0) {
+        pthread_cond_wait(&g->done_cond, &g->lock);
+    }
+    int failed = g->failed;
+    pthread_mutex_unlock(&g->lock);
+    return failed ? -1 : 0;
+}
+
+int pipeline_stage_count(pipeline *graph) {
+    if (!graph) return 0;
+    return ((pipeline_t *)graph)->num_stages;
+}
+
+int pipeline_get_stage_stats(pipeline *graph, int id, pipeline_stage_stats *stats) {
+    if (!graph || !stats) return -1;
+    pipeline_t *g = (pipeline_t *)graph;
+    if (id < 0 || id >= g->num_stages) return -1;
+    *stats = g->stages[id].stats;
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include "pixel_kernels.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Variant tables generated from pixel_kernels_impl.h; CMake defines which ones are built for the target
+extern const pixel_kernels pixel_kernels_table_scalar;
+#ifdef PIXEL_KERNELS_X86
+extern const pixel_kernels pixel_kernels_table_sse4;
+extern const pixel_kernels pixel_kernels_table_avx2;
+#endif
+#ifdef PIXEL_KERNELS_NEON
+extern const pixel_kernels pixel_kernels_table_neon;
+#endif
+
+#define SELF_CHECK_MAX_BYTES 4099
+
+static const pixel_kernels *selected_kernels = NULL;
+static pthread_once_t select_once = PTHREAD_ONCE_INIT;
+
+const pixel_kernels *pixel_kernels_get_variant(pixel_isa isa) {
+    switch (isa) {
+        case PIXEL_ISA_SCALAR:
+            return &pixel_kernels_table_scalar;
+#ifdef PIXEL_KERNELS_X86
+        case PIXEL_ISA_SSE4:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse4.1") ? &pixel_kernels_table_sse4 : NULL;
+        case PIXEL_ISA_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") ? &pixel_kernels_table_avx2 : NULL;
+#endif
+#ifdef PIXEL_KERNELS_NEON
+        case PIXEL_ISA_NEON:
+            return &pixel_kernels_table_neon;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+static unsigned int next_random(unsigned int *state) {
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 16;
+}
+
+// Run every kernel of 'variant' and the scalar reference on the same inputs and compare the outputs
+static int check_variant(const pixel_kernels *variant, unsigned char *buffers) {
+    static const int alphas[] = { 0, 1, 77, 128, 255, 256 };
+    static const int gains[] = { 0, 1, 200, 256, 300, 1024, 65535 };
+    static const size_t lengths[] = { 0, 1, 15, 16, 17, 31, 33, 63, 64, 100, 1000, SELF_CHECK_MAX_BYTES };
+    // Source and output widths in pixels for the row scaler (down- and upscales); outputs leave room for an overrun check
+    static const struct { unsigned int src, dst; } scales[] = {
+        { 1, 1 }, { 1, 7 }, { 2, 5 }, { 5, 2 }, { 7, 16 }, { 16, 7 }, { 3, 1000 }, { 1000, 3 },
+        { 640, 1280 }, { 1280, 640 }, { 1365, 1365 }, { 1365, 1364 }, { 911, 1365 },
+    };
+    const pixel_kernels *ref = &pixel_kernels_table_scalar;
+    unsigned char *a = buffers;
+    unsigned char *b = a + SELF_CHECK_MAX_BYTES;
+    unsigned char *expected = b + SELF_CHECK_MAX_BYTES;
+    unsigned char *actual = expected + SELF_CHECK_MAX_BYTES;
+    unsigned int seed = 0x5eed;
+
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        size_t n = lengths[l];
+        for (size_t i = 0; i < n; i++) {
+            a[i] = (unsigned char)next_random(&seed);
+            b[i] = (unsigned char)next_random(&seed);
+        }
+
+        for (size_t k = 0; k < sizeof(alphas) / sizeof(alphas[0]); k++) {
+            memcpy(expected, b, n);
+            memcpy(actual, b, n);
+            ref->blend(expected, a, n, alphas[k]);
+            variant->blend(actual, a, n, alphas[k]);
+            if (memcmp(expected, actual, n) != 0) {
+                printf("Pixel kernel %s: blend mismatch (n=%zu, alpha=%d)\n", variant->name, n, alphas[k]);
+                return -1;
+            }
+        }
+
+        for (size_t k = 0; k < sizeof(gains) / sizeof(gains[0]); k++) {
+            ref->gain(expected, a, n, gains[k]);
+            variant->gain(actual, a, n, gains[k]);
+            if (memcmp(expected, actual, n) != 0) {
+                printf("Pixel kernel %s: gain mismatch (n=%zu, gain=%d)\n", variant->name, n, gains[k]);
+                return -1;
+            }
+        }
+
+        ref->average_rows(expected, a, b, n);
+        variant->average_rows(actual, a, b, n);
+        if (memcmp(expected, actual, n) != 0) {
+            printf("Pixel kernel %s: average_rows mismatch (n=%zu)\n", variant->name, n);
+            return -1;
+        }
+    }
+
+    // Sample at pixel centers (as roi_scale_nearest does) and from the left edge; compare 4 bytes past the row to catch overruns
+    for (size_t s = 0; s < sizeof(scales) / sizeof(scales[0]); s++) {
+        unsigned int step = (scales[s].src << 16) / scales[s].dst;
+        size_t bytes = (size_t)scales[s].dst * 3 + 4;
+        const unsigned int starts[] = { step / 2, 0 };
+        for (size_t k = 0; k < sizeof(starts) / sizeof(starts[0]); k++) {
+            memset(expected, 0xA5, bytes);
+            memset(actual, 0xA5, bytes);
+            ref->scale_row_nearest(expected, a, scales[s].dst, starts[k], step);
+            variant->scale_row_nearest(actual, a, scales[s].dst, starts[k], step);
+            if (memcmp(expected, actual, bytes) != 0) {
+                printf("Pixel kernel %s: scale_row_nearest mismatch (%u -> %u pixels, x0=%u)\n", variant->name,
+                       scales[s].src, scales[s].dst, starts[k]);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+int pixel_kernels_self_check(void) {
+    unsigned char *buffers = (unsigned char *)malloc(4 * SELF_CHECK_MAX_BYTES);
+    if (!buffers) return -1;
+    int result = 0;
+    for (int isa = PIXEL_ISA_SCALAR + 1; isa < PIXEL_ISA_COUNT; isa++) {
+        const pixel_kernels *variant = pixel_kernels_get_variant((pixel_isa)isa);
+        if (variant && check_variant(variant, buffers) != 0) result = -1;
+    }
+    free(buffers);
+    return result;
+}
+
+// Pick the widest variant the CPU supports that agrees with the scalar reference.
+// A variant that disagrees is a build or compiler bug, so it is reported as an error rather than skipped silently.
+static void select_kernels(void) {
+    static const pixel_isa preference[] = { PIXEL_ISA_AVX2, PIXEL_ISA_NEON, PIXEL_ISA_SSE4 };
+    unsigned char *buffers = (unsigned char *)malloc(4 * SELF_CHECK_MAX_BYTES);
+    if (!buffers) printf("Pixel kernels: out of memory for the self-check, falling back to scalar\n");
+
+    selected_kernels = &pixel_kernels_table_scalar;
+    for (size_t i = 0; buffers && i < sizeof(preference) / sizeof(preference[0]); i++) {
+        const pixel_kernels *variant = pixel_kernels_get_variant(preference[i]);
+        if (!variant) continue;
+        if (check_variant(variant, buffers) == 0) {
+            selected_kernels = variant;
+            break;
+        }
+        printf("Error: pixel kernel variant %s does not match the scalar reference and is disabled\n", variant->name);
+    }
+    free(buffers);
+    printf("Pixel kernels: using %s variant\n", selected_kernels->name);
+}
+
+const pixel_kernels *pixel_kernels_get(void) {
+    pthread_once(&select_once, select_kernels);
+    return selected_kernels;
+}
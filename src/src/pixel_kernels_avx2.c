@@ -0,0 +1,4 @@
+// Pixel kernel variant: avx2 (x86, built with -mavx2)
+#define PK_SUFFIX avx2
+#define PK_VEC_BYTES 32
+#include "pixel_kernels_impl.h"
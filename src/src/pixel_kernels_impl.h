@@ -0,0 +1,111 @@
+// Single source for every pixel kernel ISA variant.
+// Include this file from a variant translation unit after defining:
+// - PK_SUFFIX: Suffix for the generated symbols (scalar, sse4, avx2, neon).
+// - PK_VEC_BYTES: Vector width in bytes, or 0 for the scalar reference.
+// The variant's compile flags (-msse4.1, -mavx2, ...) decide which instructions GCC emits for the vector types.
+// The scalar loops below are both the reference implementation and the tail handler of the vector variants.
+
+#include "pixel_kernels.h"
+#include <stdint.h>
+#include <string.h>
+
+#if !defined(PK_SUFFIX) || !defined(PK_VEC_BYTES)
+#error "Define PK_SUFFIX and PK_VEC_BYTES before including pixel_kernels_impl.h"
+#endif
+
+#define PK_CAT_(a, b) a##_##b
+#define PK_CAT(a, b) PK_CAT_(a, b)
+#define PK_FN(name) PK_CAT(name, PK_SUFFIX)
+#define PK_STR_(x) #x
+#define PK_STR(x) PK_STR_(x)
+
+#if PK_VEC_BYTES
+typedef uint16_t pk_u16 __attribute__((vector_size(PK_VEC_BYTES)));
+typedef uint32_t pk_u32 __attribute__((vector_size(PK_VEC_BYTES)));
+#endif
+
+static void PK_FN(pk_blend)(unsigned char *dst, const unsigned char *src, size_t n, int alpha) {
+    if (alpha < 0) alpha = 0;
+    if (alpha > 256) alpha = 256;
+    size_t i = 0;
+#if PK_VEC_BYTES
+    // Even and odd bytes are processed in 16-bit lanes; the weighted sum never exceeds 255 * 256
+    const uint16_t a = (uint16_t)alpha, inv = (uint16_t)(256 - alpha);
+    for (; i + PK_VEC_BYTES <= n; i += PK_VEC_BYTES) {
+        pk_u16 s, d;
+        memcpy(&s, src + i, PK_VEC_BYTES);
+        memcpy(&d, dst + i, PK_VEC_BYTES);
+        pk_u16 even = ((s & 0xFF) * a + (d & 0xFF) * inv) >> 8;
+        pk_u16 odd = ((s >> 8) * a + (d >> 8) * inv) >> 8;
+        pk_u16 r = even | (odd << 8);
+        memcpy(dst + i, &r, PK_VEC_BYTES);
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] = (unsigned char)((src[i] * alpha + dst[i] * (256 - alpha)) >> 8);
+    }
+}
+
+static void PK_FN(pk_gain)(unsigned char *dst, const unsigned char *src, size_t n, int gain) {
+    if (gain < 0) gain = 0;
+    if (gain > 65535) gain = 65535;
+    size_t i = 0;
+#if PK_VEC_BYTES
+    // Each byte of a 32-bit lane is scaled separately; 255 * 65535 fits in 32 bits
+    const uint32_t g = (uint32_t)gain;
+    for (; i + PK_VEC_BYTES <= n; i += PK_VEC_BYTES) {
+        pk_u32 s, r = { 0 };
+        memcpy(&s, src + i, PK_VEC_BYTES);
+        for (int shift = 0; shift < 32; shift += 8) {
+            pk_u32 v = (((s >> shift) & 0xFF) * g) >> 8;
+            pk_u32 over = (pk_u32)(v > 0xFF);
+            v = (v & ~over) | (over & 0xFF);
+            r |= v << shift;
+        }
+        memcpy(dst + i, &r, PK_VEC_BYTES);
+    }
+#endif
+    for (; i < n; i++) {
+        unsigned int v = ((unsigned int)src[i] * (unsigned int)gain) >> 8;
+        dst[i] = (unsigned char)(v > 255 ? 255 : v);
+    }
+}
+
+// No explicit vector path: GCC turns this loop into the rounding-average instruction of the variant's ISA
+// (pavgb/vpavgb/urhadd), which was faster than the (a | b) - ((a ^ b) >> 1) vector form at every width measured
+static void PK_FN(pk_average_rows)(unsigned char *dst, const unsigned char *a, const unsigned char *b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = (unsigned char)((a[i] + b[i] + 1) >> 1);
+    }
+}
+
+static void PK_FN(pk_scale_row_nearest)(unsigned char *dst, const unsigned char *src, size_t n, unsigned int x0, unsigned int step) {
+    if (n == 0) return;
+    unsigned int fx = x0;
+    size_t x = 0;
+#if PK_VEC_BYTES
+    // Copy each pixel as one unaligned 32-bit word; the extra byte is overwritten by the next pixel.
+    // The word also reads the first byte of the following source pixel, so the last sampled pixel
+    // and the last output pixel are left to the byte loop to stay inside both rows.
+    const unsigned int last = (x0 + (unsigned int)(n - 1) * step) >> 16;
+    for (; x + 1 < n && (fx >> 16) < last; x++, fx += step) {
+        uint32_t v;
+        memcpy(&v, src + (size_t)(fx >> 16) * 3, 4);
+        memcpy(dst + x * 3, &v, 4);
+    }
+#endif
+    for (; x < n; x++, fx += step) {
+        const unsigned char *p = src + (size_t)(fx >> 16) * 3;
+        dst[x * 3] = p[0];
+        dst[x * 3 + 1] = p[1];
+        dst[x * 3 + 2] = p[2];
+    }
+}
+
+const pixel_kernels PK_FN(pixel_kernels_table) = {
+    PK_STR(PK_SUFFIX),
+    PK_FN(pk_blend),
+    PK_FN(pk_gain),
+    PK_FN(pk_average_rows),
+    PK_FN(pk_scale_row_nearest),
+};
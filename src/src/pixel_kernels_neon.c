@@ -0,0 +1,4 @@
+// Pixel kernel variant: neon (AArch64, NEON is part of the base ISA)
+#define PK_SUFFIX neon
+#define PK_VEC_BYTES 16
+#include "pixel_kernels_impl.h"
@@ -0,0 +1,4 @@
+// Pixel kernel variant: scalar (reference, always built)
+#define PK_SUFFIX scalar
+#define PK_VEC_BYTES 0
+#include "pixel_kernels_impl.h"
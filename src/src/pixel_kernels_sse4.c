@@ -0,0 +1,4 @@
+// Pixel kernel variant: sse4 (x86, built with -msse4.1)
+#define PK_SUFFIX sse4
+#define PK_VEC_BYTES 16
+#include "pixel_kernels_impl.h"
@@ -0,0 +1,308 @@
+#include "recording.h"
+#include "thread_pool.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <limits.h>
+#include <unistd.h>
+
+#define RECORDING_WINDOW_BYTES (64u << 20) // Largest mapping kept at once, small enough for 32-bit address spaces
+
+// Read-only mapping of part of the file (mmap offsets must be page aligned, so base may start before data)
+typedef struct {
+    unsigned char *base;
+    size_t size;
+    unsigned char *data;  // First byte that was asked for
+} recording_window;
+
+typedef struct {
+    int fd;
+    off_t file_size;
+    long page_size;
+    int width, height;
+    size_t frame_size;
+    int frame_count;
+    int window_frames;         // Frames per window (at least one)
+    recording_window window;   // Window used by recording_get_frame
+    int window_first;          // First frame in window
+    int window_count;          // Frames in window (0 if nothing is mapped)
+} recording_t;
+
+// One thumbnail or contact sheet tile, executed on the thread pool
+typedef struct {
+    recording_t *rec;
+    int frame;
+    int scale;
+    unsigned char *dst;   // Tile destination (NULL: allocate and write a thumbnail file)
+    int dst_stride;
+    const char *out_dir;
+    int result;
+} thumbnail_job;
+
+// Nearest-neighbour downscale: only every 'scale'-th row of the source is touched, so most pages are never read
+static void downscale_frame(const unsigned char *src, int width, int height, int scale,
+                            unsigned char *dst, int dst_stride) {
+    int tw = width / scale, th = height / scale;
+    for (int y = 0; y < th; y++) {
+        const unsigned char *row = src + (size_t)y * scale * width * 3;
+        unsigned char *out = dst + (size_t)y * dst_stride;
+        for (int x = 0; x < tw; x++) {
+            memcpy(out + x * 3, row + (size_t)x * scale * 3, 3);
+        }
+    }
+}
+
+// Map frames [first, first + count) of the recording
+static int map_frames(recording_t *r, int first, int count, recording_window *w) {
+    off_t offset = (off_t)first * (off_t)r->frame_size;
+    off_t aligned = offset - offset % r->page_size;
+    w->size = (size_t)count * r->frame_size + (size_t)(offset - aligned);
+    void *map = mmap(NULL, w->size, PROT_READ, MAP_SHARED, r->fd, aligned);
+    if (map == MAP_FAILED) {
+        printf("Failed to map frames %d-%d of the recording\n", first, first + count - 1);
+        w->base = NULL;
+        return -1;
+    }
+    w->base = (unsigned char *)map;
+    w->data = w->base + (offset - aligned);
+    return 0;
+}
+
+static void unmap_frames(recording_window *w) {
+    if (w->base) munmap(w->base, w->size);
+    w->base = NULL;
+}
+
+static void thumbnail_task(void *arg) {
+    thumbnail_job *job = (thumbnail_job *)arg;
+    recording_t *r = job->rec;
+    int tw = r->width / job->scale, th = r->height / job->scale;
+    // Every job maps its own frame, so jobs do not share the recording_get_frame window
+    recording_window w;
+    if (map_frames(r, job->frame, 1, &w) != 0) {
+        job->result = -1;
+        return;
+    }
+
+    if (job->dst) {
+        downscale_frame(w.data, r->width, r->height, job->scale, job->dst, job->dst_stride);
+        unmap_frames(&w);
+        job->result = 0;
+        return;
+    }
+
+    unsigned char *thumb = (unsigned char *)malloc((size_t)tw * th * 3);
+    if (!thumb) {
+        unmap_frames(&w);
+        job->result = -1;
+        return;
+    }
+    downscale_frame(w.data, r->width, r->height, job->scale, thumb, tw * 3);
+    unmap_frames(&w);
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/frame_%06d.ppm", job->out_dir, job->frame);
+    job->result = recording_write_ppm(path, thumb, tw, th, tw * 3);
+    free(thumb);
+}
+
+// Run the jobs on a pool sized to the CPU count; tearing the pool down waits for every job
+static int run_jobs(thumbnail_job *jobs, int count) {
+    thread_pool *pool;
+    if (thread_pool_init(&pool, 0) != 0) return -1;
+    for (int i = 0; i < count; i++) {
+        if (thread_pool_submit(pool, thumbnail_task, &jobs[i]) != 0) {
+            thumbnail_task(&jobs[i]);
+        }
+    }
+    thread_pool_uninit(pool);
+
+    int result = 0;
+    for (int i = 0; i < count; i++) {
+        if (jobs[i].result != 0) {
+            printf("Failed to extract frame %d\n", jobs[i].frame);
+            result = -1;
+        }
+    }
+    return result;
+}
+
+static int check_selection(recording_t *r, int first, int count, int step, int scale) {
+    if (first < 0 || count <= 0 || step <= 0 || scale <= 0) return -1;
+    if (r->width / scale == 0 || r->height / scale == 0) return -1;
+    if ((long long)first + (long long)(count - 1) * step >= r->frame_count) {
+        printf("Frame selection exceeds the %d frames in the recording\n", r->frame_count);
+        return -1;
+    }
+    return 0;
+}
+
+int recording_open(recording **rec, const char *path, int width, int height) {
+    if (rec == NULL || path == NULL || width <= 0 || height <= 0) return -1;
+    recording_t *new_rec = (recording_t *)calloc(1, sizeof(recording_t));
+    if (!new_rec) return -1;
+
+    new_rec->fd = open(path, O_RDONLY);
+    if (new_rec->fd < 0) {
+        printf("Failed to open recording: %s\n", path);
+        free(new_rec);
+        return -1;
+    }
+    struct stat st;
+    if (fstat(new_rec->fd, &st) != 0) {
+        close(new_rec->fd);
+        free(new_rec);
+        return -1;
+    }
+
+    // Nothing is mapped here: frames are mapped in windows on demand, so the file may exceed the address space
+    new_rec->width = width;
+    new_rec->height = height;
+    new_rec->frame_size = (size_t)width * height * 3; // RGB888, as written while saving
+    new_rec->file_size = st.st_size;
+    new_rec->page_size = sysconf(_SC_PAGESIZE);
+    off_t frames = new_rec->file_size / (off_t)new_rec->frame_size;
+    if (frames > INT_MAX || new_rec->page_size <= 0) {
+        printf("Recording %s is too large for %dx%d frames\n", path, width, height);
+        close(new_rec->fd);
+        free(new_rec);
+        return -1;
+    }
+    new_rec->frame_count = (int)frames;
+    new_rec->window_frames = (int)(RECORDING_WINDOW_BYTES / new_rec->frame_size);
+    if (new_rec->window_frames == 0) new_rec->window_frames = 1;
+
+    *rec = (recording *)new_rec;
+    return 0;
+}
+
+int recording_close(recording *rec) {
+    if (!rec) return -1;
+    recording_t *r = (recording_t *)rec;
+    unmap_frames(&r->window);
+    close(r->fd);
+    free(r);
+    return 0;
+}
+
+int recording_frame_count(recording *rec) {
+    if (!rec) return 0;
+    return ((recording_t *)rec)->frame_count;
+}
+
+const unsigned char *recording_get_frame(recording *rec, int index) {
+    if (!rec) return NULL;
+    recording_t *r = (recording_t *)rec;
+    if (index < 0 || index >= r->frame_count) return NULL;
+
+    // Remap only when the frame falls outside the current window; the window starts at the requested frame
+    if (index < r->window_first || index >= r->window_first + r->window_count) {
+        unmap_frames(&r->window);
+        r->window_count = 0;
+        int count = r->frame_count - index < r->window_frames ? r->frame_count - index : r->window_frames;
+        if (map_frames(r, index, count, &r->window) != 0) return NULL;
+        r->window_first = index;
+        r->window_count = count;
+    }
+    return r->window.data + (size_t)(index - r->window_first) * r->frame_size;
+}
+
+int recording_export_range(recording *rec, int first, int count, const char *out_path) {
+    if (!rec || !out_path) return -1;
+    recording_t *r = (recording_t *)rec;
+    if (first < 0 || count <= 0 || first > r->frame_count - count) return -1;
+
+    FILE *out = fopen(out_path, "wb");
+    if (!out) {
+        printf("Failed to open output file: %s\n", out_path);
+        return -1;
+    }
+    // Frames are contiguous, so each window is written in one go straight from its mapping
+    int result = 0;
+    for (int done = 0; done < count && result == 0; ) {
+        int chunk = count - done < r->window_frames ? count - done : r->window_frames;
+        recording_window w;
+        if (map_frames(r, first + done, chunk, &w) != 0) {
+            result = -1;
+            break;
+        }
+        size_t size = (size_t)chunk * r->frame_size;
+        posix_madvise(w.base, w.size, POSIX_MADV_SEQUENTIAL);
+        if (fwrite(w.data, 1, size, out) != size) result = -1;
+        unmap_frames(&w);
+        done += chunk;
+    }
+    if (fclose(out) != 0) result = -1;
+    if (result != 0) printf("Error writing frames to %s\n", out_path);
+    return result;
+}
+
+int recording_extract_thumbnails(recording *rec, int first, int count, int step, int scale, const char *out_dir) {
+    if (!rec || !out_dir) return -1;
+    recording_t *r = (recording_t *)rec;
+    if (check_selection(r, first, count, step, scale) != 0) return -1;
+
+    thumbnail_job *jobs = (thumbnail_job *)calloc(count, sizeof(thumbnail_job));
+    if (!jobs) return -1;
+    for (int i = 0; i < count; i++) {
+        jobs[i].rec = r;
+        jobs[i].frame = first + i * step;
+        jobs[i].scale = scale;
+        jobs[i].out_dir = out_dir;
+        jobs[i].result = -1;
+    }
+    int result = run_jobs(jobs, count);
+    free(jobs);
+    return result;
+}
+
+int recording_contact_sheet(recording *rec, int first, int count, int step, int columns, int scale, const char *out_path) {
+    if (!rec || !out_path || columns <= 0) return -1;
+    recording_t *r = (recording_t *)rec;
+    if (check_selection(r, first, count, step, scale) != 0) return -1;
+
+    int tw = r->width / scale, th = r->height / scale;
+    if (columns > count) columns = count;
+    int rows = (count + columns - 1) / columns;
+    int sheet_width = tw * columns, sheet_height = th * rows;
+    unsigned char *sheet = (unsigned char *)calloc((size_t)sheet_width * sheet_height, 3);
+    thumbnail_job *jobs = (thumbnail_job *)calloc(count, sizeof(thumbnail_job));
+    if (!sheet || !jobs) {
+        free(sheet);
+        free(jobs);
+        return -1;
+    }
+
+    // Each tile is written by its own job into a disjoint region of the sheet
+    for (int i = 0; i < count; i++) {
+        jobs[i].rec = r;
+        jobs[i].frame = first + i * step;
+        jobs[i].scale = scale;
+        jobs[i].dst = sheet + ((size_t)(i / columns) * th * sheet_width + (size_t)(i % columns) * tw) * 3;
+        jobs[i].dst_stride = sheet_width * 3;
+        jobs[i].result = -1;
+    }
+    int result = run_jobs(jobs, count);
+    if (result == 0) result = recording_write_ppm(out_path, sheet, sheet_width, sheet_height, sheet_width * 3);
+    free(jobs);
+    free(sheet);
+    return result;
+}
+
+int recording_write_ppm(const char *path, const unsigned char *data, int width, int height, int stride) {
+    if (!path || !data) return -1;
+    FILE *out = fopen(path, "wb");
+    if (!out) {
+        printf("Failed to open output file: %s\n", path);
+        return -1;
+    }
+    int result = 0;
+    fprintf(out, "P6\n%d %d\n255\n", width, height);
+    for (int y = 0; y < height && result == 0; y++) {
+        if (fwrite(data + (size_t)y * stride, 1, (size_t)width * 3, out) != (size_t)width * 3) result = -1;
+    }
+    if (fclose(out) != 0) result = -1;
+    return result;
+}
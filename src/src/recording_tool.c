@@ -0,0 +1,102 @@
+// High-Level Explanation:
+// This module is a command-line front end for the recording reader (recording.h).
+// It opens a raw RGB888 recording saved by the video pipeline and prints information, extracts single frames,
+// exports frame ranges, and writes thumbnails or contact sheets without reading the whole file.
+
+// Important Functions:
+// - print_usage: Prints the supported commands.
+// - parse_int: Converts a numeric argument, rejecting anything that is not a whole integer.
+// - main: Parses the command line, opens the recording, and runs the requested command.
+
+// Inputs and Outputs:
+// - Inputs: Recording path, frame width/height, command and its arguments (argv).
+// - Outputs: Image/raw files, information on stdout, return code (int).
+
+#include "recording.h"
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s <recording> <width> <height> <command> [args]\n", prog);
+    printf("Commands:\n");
+    printf("  info                                       Print the number of frames\n");
+    printf("  frame <index> <out.ppm>                    Write one frame as a PPM image\n");
+    printf("  export <first> <count> <out.raw>           Write a range of frames as a raw recording\n");
+    printf("  thumbs <first> <count> <step> <scale> <dir>   Write downscaled thumbnails to <dir>\n");
+    printf("  sheet <first> <count> <step> <columns> <scale> <out.ppm>   Write a contact sheet\n");
+}
+
+static int parse_int(const char *text, int *value) {
+    char *end;
+    errno = 0;
+    long v = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || v < INT_MIN || v > INT_MAX) {
+        printf("Invalid number: %s\n", text);
+        return -1;
+    }
+    *value = (int)v;
+    return 0;
+}
+
+// Parse the first 'count' arguments as integers into values
+static int parse_ints(char **args, int count, int *values) {
+    for (int i = 0; i < count; i++) {
+        if (parse_int(args[i], &values[i]) != 0) return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    const char *command = argv[4];
+    int nargs = argc - 5;
+    char **args = argv + 5;
+    int width, height, v[5];
+    if (parse_int(argv[2], &width) != 0 || parse_int(argv[3], &height) != 0) return 1;
+
+    // Validate the command and its numeric arguments before touching the recording
+    int command_ok = (strcmp(command, "info") == 0 && nargs == 0) ||
+                     (strcmp(command, "frame") == 0 && nargs == 2) ||
+                     (strcmp(command, "export") == 0 && nargs == 3) ||
+                     (strcmp(command, "thumbs") == 0 && nargs == 5) ||
+                     (strcmp(command, "sheet") == 0 && nargs == 6);
+    if (!command_ok) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (nargs > 0 && parse_ints(args, nargs - 1, v) != 0) return 1;
+
+    recording *rec;
+    if (recording_open(&rec, argv[1], width, height) != 0) {
+        printf("Failed to open recording %s\n", argv[1]);
+        return 1;
+    }
+
+    int result = -1;
+    if (strcmp(command, "info") == 0) {
+        printf("%s: %d frames of %dx%d RGB888\n", argv[1], recording_frame_count(rec), width, height);
+        result = 0;
+    } else if (strcmp(command, "frame") == 0) {
+        const unsigned char *frame = recording_get_frame(rec, v[0]);
+        if (frame) {
+            result = recording_write_ppm(args[1], frame, width, height, width * 3);
+        } else {
+            printf("Frame %d is out of range\n", v[0]);
+        }
+    } else if (strcmp(command, "export") == 0) {
+        result = recording_export_range(rec, v[0], v[1], args[2]);
+    } else if (strcmp(command, "thumbs") == 0) {
+        result = recording_extract_thumbnails(rec, v[0], v[1], v[2], v[3], args[4]);
+    } else {
+        result = recording_contact_sheet(rec, v[0], v[1], v[2], v[3], v[4], args[5]);
+    }
+
+    recording_close(rec);
+    return result == 0 ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+#include "roi.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ROI_EASING 0.25 // Fraction of the remaining distance covered per frame while zooming
+
+typedef enum {
+    ROI_TARGET_FULL,
+    ROI_TARGET_RECT,
+    ROI_TARGET_ZOOM
+} roi_target;
+
+typedef struct {
+    pthread_mutex_t lock;
+    roi_target target;
+    roi_rect rect;
+    int zoom_percent;
+    int center_x, center_y;
+    double cur_x, cur_y, cur_w, cur_h; // Current ROI, eased toward the target
+    int frame_width, frame_height;     // Frame size the current ROI refers to (0 before the first frame)
+} roi_t;
+
+static double clampd(double v, double lo, double hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+// Resolve the target into a rectangle inside a frame of fw x fh
+static void resolve_target(roi_t *r, int fw, int fh, double *x, double *y, double *w, double *h) {
+    switch (r->target) {
+        case ROI_TARGET_RECT:
+            *w = clampd(r->rect.width, 1, fw);
+            *h = clampd(r->rect.height, 1, fh);
+            *x = clampd(r->rect.x, 0, fw - *w);
+            *y = clampd(r->rect.y, 0, fh - *h);
+            return;
+        case ROI_TARGET_ZOOM:
+            *w = clampd((double)fw * 100.0 / r->zoom_percent, 1, fw);
+            *h = clampd((double)fh * 100.0 / r->zoom_percent, 1, fh);
+            *x = clampd(r->center_x - *w / 2, 0, fw - *w);
+            *y = clampd(r->center_y - *h / 2, 0, fh - *h);
+            return;
+        case ROI_TARGET_FULL:
+            break;
+    }
+    *x = 0;
+    *y = 0;
+    *w = fw;
+    *h = fh;
+}
+
+int roi_init(roi **r) {
+    if (r == NULL) return -1;
+    roi_t *new_roi = (roi_t *)calloc(1, sizeof(roi_t));
+    if (!new_roi) return -1;
+    pthread_mutex_init(&new_roi->lock, NULL);
+    new_roi->target = ROI_TARGET_FULL;
+    new_roi->zoom_percent = 100;
+    *r = (roi *)new_roi;
+    return 0;
+}
+
+int roi_uninit(roi *r) {
+    if (!r) return -1;
+    roi_t *rt = (roi_t *)r;
+    pthread_mutex_destroy(&rt->lock);
+    free(rt);
+    return 0;
+}
+
+int roi_set_rect(roi *r, const roi_rect *rect) {
+    if (!r || !rect) return -1;
+    roi_t *rt = (roi_t *)r;
+    pthread_mutex_lock(&rt->lock);
+    rt->target = (rect->width > 0 && rect->height > 0) ? ROI_TARGET_RECT : ROI_TARGET_FULL;
+    rt->rect = *rect;
+    pthread_mutex_unlock(&rt->lock);
+    return 0;
+}
+
+int roi_set_zoom(roi *r, int zoom_percent, int center_x, int center_y) {
+    if (!r || zoom_percent < 100) return -1;
+    roi_t *rt = (roi_t *)r;
+    pthread_mutex_lock(&rt->lock);
+    rt->target = zoom_percent == 100 ? ROI_TARGET_FULL : ROI_TARGET_ZOOM;
+    rt->zoom_percent = zoom_percent;
+    rt->center_x = center_x;
+    rt->center_y = center_y;
+    pthread_mutex_unlock(&rt->lock);
+    return 0;
+}
+
+int roi_apply(roi *r, const pipeline_frame *frame, pipeline_frame *view) {
+    if (!r || !frame || !view) return -1;
+    roi_t *rt = (roi_t *)r;
+    double tx, ty, tw, th;
+
+    pthread_mutex_lock(&rt->lock);
+    resolve_target(rt, frame->width, frame->height, &tx, &ty, &tw, &th);
+    if (rt->frame_width != frame->width || rt->frame_height != frame->height) {
+        // First frame or new resolution: jump straight to the target
+        rt->frame_width = frame->width;
+        rt->frame_height = frame->height;
+        rt->cur_x = tx;
+        rt->cur_y = ty;
+        rt->cur_w = tw;
+        rt->cur_h = th;
+    } else {
+        rt->cur_x += (tx - rt->cur_x) * ROI_EASING;
+        rt->cur_y += (ty - rt->cur_y) * ROI_EASING;
+        rt->cur_w += (tw - rt->cur_w) * ROI_EASING;
+        rt->cur_h += (th - rt->cur_h) * ROI_EASING;
+        if (abs((int)(tw - rt->cur_w)) < 1 && abs((int)(th - rt->cur_h)) < 1 &&
+            abs((int)(tx - rt->cur_x)) < 1 && abs((int)(ty - rt->cur_y)) < 1) {
+            rt->cur_x = tx;
+            rt->cur_y = ty;
+            rt->cur_w = tw;
+            rt->cur_h = th;
+        }
+    }
+    roi_rect rect = { (int)(rt->cur_x + 0.5), (int)(rt->cur_y + 0.5), (int)(rt->cur_w + 0.5), (int)(rt->cur_h + 0.5) };
+    pthread_mutex_unlock(&rt->lock);
+
+    return roi_make_view(frame, &rect, view);
+}
+
+int roi_make_view(const pipeline_frame *frame, const roi_rect *rect, pipeline_frame *view) {
+    if (!frame || !frame->data || !rect || !view) return -1;
+    if (frame->width <= 0 || frame->height <= 0) return -1;
+    int stride = frame->stride ? frame->stride : frame->width * 3;
+
+    roi_rect clamped = *rect;
+    if (clamped.width <= 0 || clamped.height <= 0) {
+        clamped.x = 0;
+        clamped.y = 0;
+        clamped.width = frame->width;
+        clamped.height = frame->height;
+    }
+    if (clamped.x < 0) clamped.x = 0;
+    if (clamped.y < 0) clamped.y = 0;
+    if (clamped.x > frame->width - 1) clamped.x = frame->width - 1;
+    if (clamped.y > frame->height - 1) clamped.y = frame->height - 1;
+    if (clamped.width > frame->width - clamped.x) clamped.width = frame->width - clamped.x;
+    if (clamped.height > frame->height - clamped.y) clamped.height = frame->height - clamped.y;
+
+    *view = *frame;
+    view->data = frame->data + (size_t)clamped.y * stride + (size_t)clamped.x * 3; // RGB888
+    view->width = clamped.width;
+    view->height = clamped.height;
+    view->stride = stride;
+    return 0;
+}
+
+void roi_scale_nearest(const pixel_kernels *kernels, const unsigned char *src, int src_width, int src_height, int src_stride,
+                       unsigned char *dst, int dst_width, int dst_height, int dst_stride) {
+    if (!kernels || dst_width <= 0 || dst_height <= 0 || src_width <= 0 || src_height <= 0) return;
+    // 16.16 fixed-point steps, sampling at pixel centers
+    unsigned int step_x = ((unsigned int)src_width << 16) / (unsigned int)dst_width;
+    unsigned int step_y = ((unsigned int)src_height << 16) / (unsigned int)dst_height;
+    unsigned int fy = step_y / 2;
+    int prev_sy = -1;
+
+    for (int y = 0; y < dst_height; y++, fy += step_y) {
+        int sy = (int)(fy >> 16);
+        unsigned char *out = dst + (size_t)y * dst_stride;
+        if (sy == prev_sy) {
+            // Upscaling repeats source rows: reuse the row just produced
+            memcpy(out, out - dst_stride, (size_t)dst_width * 3);
+            continue;
+        }
+        prev_sy = sy;
+        kernels->scale_row_nearest(out, src + (size_t)sy * src_stride, (size_t)dst_width, step_x / 2, step_x);
+    }
+}
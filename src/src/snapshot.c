@@ -0,0 +1,226 @@
+#include "snapshot.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <zlib.h>
+
+#define SNAPSHOT_MAX_NAME_TRIES 100
+
+typedef struct {
+    const unsigned char *data; // Held camera buffer
+    int width, height;
+    unsigned long sequence;
+    time_t taken;              // Wall-clock time of the capture, used in the file name
+} snapshot_job;
+
+typedef struct {
+    CameraWrapper *camera;
+    char *output_dir;
+    pthread_t worker_id;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    snapshot_job queue[SNAPSHOT_QUEUE_DEPTH];
+    int head, count;
+    int requested;
+    int stopping;
+} snapshot_t;
+
+static void put_u32(unsigned char *p, unsigned long v) {
+    p[0] = (unsigned char)(v >> 24);
+    p[1] = (unsigned char)(v >> 16);
+    p[2] = (unsigned char)(v >> 8);
+    p[3] = (unsigned char)v;
+}
+
+// Write one PNG chunk (length, type, data, CRC over type and data)
+static int write_chunk(FILE *out, const char *type, const unsigned char *data, size_t size) {
+    unsigned char header[8], crc_bytes[4];
+    put_u32(header, (unsigned long)size);
+    memcpy(header + 4, type, 4);
+    unsigned long crc = crc32(0L, (const Bytef *)type, 4);
+    if (size) crc = crc32(crc, data, (uInt)size);
+    put_u32(crc_bytes, crc);
+    if (fwrite(header, 1, 8, out) != 8) return -1;
+    if (size && fwrite(data, 1, size, out) != size) return -1;
+    return fwrite(crc_bytes, 1, 4, out) == 4 ? 0 : -1;
+}
+
+// Create a new file named after the capture time and frame, never replacing stills from this or an earlier run
+static FILE *create_snapshot_file(const char *output_dir, const snapshot_job *job, char *path, size_t path_size) {
+    struct tm local;
+    char stamp[32];
+    localtime_r(&job->taken, &local);
+    strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", &local);
+
+    for (int attempt = 0; attempt < SNAPSHOT_MAX_NAME_TRIES; attempt++) {
+        if (attempt == 0) {
+            snprintf(path, path_size, "%s/snapshot_%s_%06lu.png", output_dir, stamp, job->sequence);
+        } else {
+            snprintf(path, path_size, "%s/snapshot_%s_%06lu_%d.png", output_dir, stamp, job->sequence, attempt);
+        }
+        FILE *out = fopen(path, "wbx"); // Exclusive create: fails if the name is taken
+        if (out || errno != EEXIST) return out;
+    }
+    return NULL;
+}
+
+// Encode an RGB888 frame as a PNG (Sub filter on every row, zlib compression)
+static int write_png(const char *output_dir, const snapshot_job *job, char *path, size_t path_size) {
+    const unsigned char *data = job->data;
+    int width = job->width, height = job->height;
+    size_t row_bytes = (size_t)width * 3;
+    size_t raw_size = (row_bytes + 1) * height;
+    unsigned char *raw = (unsigned char *)malloc(raw_size);
+    uLongf packed_size = compressBound((uLong)raw_size);
+    unsigned char *packed = (unsigned char *)malloc(packed_size);
+    if (!raw || !packed) {
+        free(raw);
+        free(packed);
+        return -1;
+    }
+
+    for (int y = 0; y < height; y++) {
+        const unsigned char *src = data + (size_t)y * row_bytes;
+        unsigned char *dst = raw + (size_t)y * (row_bytes + 1);
+        dst[0] = 1; // Sub filter: each byte minus the same channel of the pixel to its left
+        memcpy(dst + 1, src, 3);
+        for (size_t i = 3; i < row_bytes; i++) dst[1 + i] = (unsigned char)(src[i] - src[i - 3]);
+    }
+    int result = compress2(packed, &packed_size, raw, (uLong)raw_size, Z_DEFAULT_COMPRESSION) == Z_OK ? 0 : -1;
+    free(raw);
+
+    FILE *out = result == 0 ? create_snapshot_file(output_dir, job, path, path_size) : NULL;
+    if (!out) {
+        printf("Failed to write snapshot of frame %lu to %s\n", job->sequence, output_dir);
+        free(packed);
+        return -1;
+    }
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    unsigned char ihdr[13];
+    put_u32(ihdr, (unsigned long)width);
+    put_u32(ihdr + 4, (unsigned long)height);
+    ihdr[8] = 8;  // Bit depth
+    ihdr[9] = 2;  // Color type: truecolor RGB
+    ihdr[10] = 0; // Deflate
+    ihdr[11] = 0; // Adaptive filtering
+    ihdr[12] = 0; // No interlace
+    if (fwrite(signature, 1, 8, out) != 8 ||
+        write_chunk(out, "IHDR", ihdr, sizeof(ihdr)) != 0 ||
+        write_chunk(out, "IDAT", packed, packed_size) != 0 ||
+        write_chunk(out, "IEND", NULL, 0) != 0) {
+        result = -1;
+    }
+    if (fclose(out) != 0) result = -1;
+    free(packed);
+    return result;
+}
+
+static void *snapshot_worker(void *arg) {
+    snapshot_t *s = (snapshot_t *)arg;
+    while (1) {
+        pthread_mutex_lock(&s->lock);
+        while (s->count == 0 && !s->stopping) {
+            pthread_cond_wait(&s->cond, &s->lock);
+        }
+        if (s->count == 0) {
+            pthread_mutex_unlock(&s->lock);
+            break;
+        }
+        snapshot_job job = s->queue[s->head];
+        s->head = (s->head + 1) % SNAPSHOT_QUEUE_DEPTH;
+        s->count--;
+        pthread_mutex_unlock(&s->lock);
+
+        char path[4096];
+        if (write_png(s->output_dir, &job, path, sizeof(path)) == 0) {
+            printf("Snapshot saved to %s\n", path);
+        }
+        camera_release_held_frame(s->camera, job.data);
+    }
+    return NULL;
+}
+
+int snapshot_init(snapshot **snap, CameraWrapper *camera, const char *output_dir) {
+    if (snap == NULL || camera == NULL || output_dir == NULL) return -1;
+    snapshot_t *new_snap = (snapshot_t *)calloc(1, sizeof(snapshot_t));
+    if (!new_snap) return -1;
+    new_snap->camera = camera;
+    new_snap->output_dir = strdup(output_dir);
+    if (!new_snap->output_dir) {
+        free(new_snap);
+        return -1;
+    }
+    pthread_mutex_init(&new_snap->lock, NULL);
+    pthread_cond_init(&new_snap->cond, NULL);
+    if (pthread_create(&new_snap->worker_id, NULL, snapshot_worker, new_snap) != 0) {
+        printf("Snapshot worker creation failed!\n");
+        pthread_cond_destroy(&new_snap->cond);
+        pthread_mutex_destroy(&new_snap->lock);
+        free(new_snap->output_dir);
+        free(new_snap);
+        return -1;
+    }
+    *snap = (snapshot *)new_snap;
+    return 0;
+}
+
+int snapshot_uninit(snapshot *snap) {
+    if (!snap) return -1;
+    snapshot_t *s = (snapshot_t *)snap;
+    pthread_mutex_lock(&s->lock);
+    s->stopping = 1;
+    pthread_cond_signal(&s->cond);
+    pthread_mutex_unlock(&s->lock);
+    pthread_join(s->worker_id, NULL);
+
+    pthread_cond_destroy(&s->cond);
+    pthread_mutex_destroy(&s->lock);
+    free(s->output_dir);
+    free(s);
+    return 0;
+}
+
+int snapshot_request(snapshot *snap) {
+    if (!snap) return -1;
+    snapshot_t *s = (snapshot_t *)snap;
+    pthread_mutex_lock(&s->lock);
+    s->requested++;
+    pthread_mutex_unlock(&s->lock);
+    return 0;
+}
+
+int snapshot_capture(snapshot *snap, const unsigned char *data, int width, int height, unsigned long sequence) {
+    if (!snap || !data) return -1;
+    snapshot_t *s = (snapshot_t *)snap;
+    pthread_mutex_lock(&s->lock);
+    if (s->requested == 0) {
+        pthread_mutex_unlock(&s->lock);
+        return 0;
+    }
+    s->requested--;
+
+    // Never wait for the worker: drop the request if the queue or the camera's spare buffers are exhausted
+    if (s->count == SNAPSHOT_QUEUE_DEPTH) {
+        pthread_mutex_unlock(&s->lock);
+        printf("Snapshot queue full, dropping snapshot of frame %lu\n", sequence);
+        return -1;
+    }
+    if (camera_hold_frame(s->camera, data) != 0) {
+        pthread_mutex_unlock(&s->lock);
+        printf("No spare camera buffer to hold, dropping snapshot of frame %lu\n", sequence);
+        return -1;
+    }
+    snapshot_job *job = &s->queue[(s->head + s->count) % SNAPSHOT_QUEUE_DEPTH];
+    job->data = data;
+    job->width = width;
+    job->height = height;
+    job->sequence = sequence;
+    job->taken = time(NULL);
+    s->count++;
+    pthread_cond_signal(&s->cond);
+    pthread_mutex_unlock(&s->lock);
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include "stages.h"
+#include <stdio.h>
+
+// Source stage: grab the next frame from the camera
+static int capture_stage(void *arg, const pipeline_frame *in, pipeline_frame *out) {
+    stages_context *ctx = (stages_context *)arg;
+    (void)in;
+    if (camera_capture_frame(ctx->camera, &out->data, &out->width, &out->height) != 0) {
+        printf("Failed to capture frame!\n");
+        return -1;
+    }
+    out->stride = out->width * 3;
+    return 0;
+}
+
+// Double-buffer the frame through the ISP and forward the current buffer
+static int isp_stage(void *arg, const pipeline_frame *in, pipeline_frame *out) {
+    stages_context *ctx = (stages_context *)arg;
+    isp_program_R0(ctx->isp_camera, in->data, in->width, in->height);
+    isp_program_R1(ctx->isp_camera, in->data, in->width, in->height); // Same frame for simplicity
+    out->data = isp_get_current_buffer(ctx->isp_camera, &out->width, &out->height);
+    out->stride = out->width * 3;
+    return 0;
+}
+
+// Crop the frame to a consumer's region of interest without copying
+static int roi_stage(void *arg, const pipeline_frame *in, pipeline_frame *out) {
+    return roi_apply((roi *)arg, in, out);
+}
+
+static int display_stage(void *arg, const pipeline_frame *in, pipeline_frame *out) {
+    stages_context *ctx = (stages_context *)arg;
+    (void)out;
+    if (display_display_view(ctx->screen, in->data, in->width, in->height, in->stride, encoder_is_saving(ctx->recorder)) != 0) {
+        printf("Failed to display frame!\n");
+        return -1;
+    }
+    return 0;
+}
+
+// Encode frame (or its ROI view) only if saving is enabled; this is the only place the recording is written
+static int encode_stage(void *arg, const pipeline_frame *in, pipeline_frame *out) {
+    stages_context *ctx = (stages_context *)arg;
+    (void)out;
+    if (!encoder_is_saving(ctx->recorder)) return 0;
+    if (encoder_encode_view(ctx->recorder, in->data, in->width, in->height, in->stride) != 0) {
+        printf("Failed to encode frame!\n");
+        return -1;
+    }
+    return 0;
+}
+
+// Hand the frame to the snapshot worker if a still was requested (never blocks the capture path)
+static int snapshot_stage(void *arg, const pipeline_frame *in, pipeline_frame *out) {
+    stages_context *ctx = (stages_context *)arg;
+    (void)out;
+    snapshot_capture(ctx->snapshots, in->data, in->width, in->height, in->sequence);
+    return 0;
+}
+
+int stages_register(pipeline *graph, stages_context *ctx) {
+    if (!graph || !ctx) return -1;
+
+    int capture = pipeline_add_stage(graph, "capture", capture_stage, ctx, PIPELINE_FORMAT_NONE, PIPELINE_FORMAT_RGB888);
+    int isp = pipeline_add_stage(graph, "isp", isp_stage, ctx, PIPELINE_FORMAT_RGB888, PIPELINE_FORMAT_RGB888);
+    int show = pipeline_add_stage(graph, "display", display_stage, ctx, PIPELINE_FORMAT_RGB888, PIPELINE_FORMAT_NONE);
+    int encode = pipeline_add_stage(graph, "encode", encode_stage, ctx, PIPELINE_FORMAT_RGB888, PIPELINE_FORMAT_NONE);
+    if (capture < 0 || isp < 0 || show < 0 || encode < 0) return -1;
+
+    if (pipeline_connect(graph, capture, isp) != 0) return -1;
+
+    // Each consumer reads either the ISP output or its own ROI view of it
+    int show_src = isp, encode_src = isp;
+    if (ctx->display_roi) {
+        show_src = pipeline_add_stage(graph, "display_roi", roi_stage, ctx->display_roi, PIPELINE_FORMAT_RGB888, PIPELINE_FORMAT_RGB888);
+        if (show_src < 0 || pipeline_connect(graph, isp, show_src) != 0) return -1;
+    }
+    if (ctx->record_roi) {
+        encode_src = pipeline_add_stage(graph, "record_roi", roi_stage, ctx->record_roi, PIPELINE_FORMAT_RGB888, PIPELINE_FORMAT_RGB888);
+        if (encode_src < 0 || pipeline_connect(graph, isp, encode_src) != 0) return -1;
+    }
+    if (pipeline_connect(graph, show_src, show) != 0) return -1;
+    if (pipeline_connect(graph, encode_src, encode) != 0) return -1;
+
+    if (ctx->snapshots) {
+        int still = pipeline_add_stage(graph, "snapshot", snapshot_stage, ctx, PIPELINE_FORMAT_RGB888, PIPELINE_FORMAT_NONE);
+        if (still < 0 || pipeline_connect(graph, capture, still) != 0) return -1;
+    }
+    return 0;
+}
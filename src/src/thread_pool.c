@@ -0,0 +1,235 @@
+#include "thread_pool.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define THREAD_POOL_MAX_THREADS 64
+#define THREAD_POOL_INITIAL_CAPACITY 64
+
+typedef struct {
+    void (*fn)(void *);
+    void *arg;
+} thread_pool_task;
+
+// Per-worker deque: the owner works at the bottom, thieves take from the top
+typedef struct {
+    pthread_t thread_id;
+    pthread_mutex_t lock;
+    thread_pool_task *tasks;
+    int capacity;
+    int top;    // Index of the oldest task (steal end)
+    int count;  // Number of queued tasks
+    int index;
+    struct thread_pool_s *pool;
+} thread_pool_worker;
+
+typedef struct thread_pool_s {
+    thread_pool_worker *workers;
+    int num_threads;
+    pthread_mutex_t idle_lock;
+    pthread_cond_t idle_cond;
+    int pending;      // Tasks queued but not yet taken by a worker
+    int stopping;
+    unsigned int next_worker;
+} thread_pool_t;
+
+// Worker that is executing on the current thread (NULL outside the pool)
+static _Thread_local thread_pool_worker *current_worker = NULL;
+
+static int deque_push_bottom(thread_pool_worker *w, thread_pool_task task) {
+    pthread_mutex_lock(&w->lock);
+    if (w->count == w->capacity) {
+        int new_capacity = w->capacity * 2;
+        thread_pool_task *grown = (thread_pool_task *)malloc(sizeof(thread_pool_task) * new_capacity);
+        if (!grown) {
+            pthread_mutex_unlock(&w->lock);
+            return -1;
+        }
+        for (int i = 0; i < w->count; i++) {
+            grown[i] = w->tasks[(w->top + i) % w->capacity];
+        }
+        free(w->tasks);
+        w->tasks = grown;
+        w->capacity = new_capacity;
+        w->top = 0;
+    }
+    w->tasks[(w->top + w->count) % w->capacity] = task;
+    w->count++;
+    pthread_mutex_unlock(&w->lock);
+    return 0;
+}
+
+static int deque_pop_bottom(thread_pool_worker *w, thread_pool_task *task) {
+    int found = 0;
+    pthread_mutex_lock(&w->lock);
+    if (w->count > 0) {
+        w->count--;
+        *task = w->tasks[(w->top + w->count) % w->capacity];
+        found = 1;
+    }
+    pthread_mutex_unlock(&w->lock);
+    return found;
+}
+
+static int deque_steal_top(thread_pool_worker *w, thread_pool_task *task) {
+    int found = 0;
+    pthread_mutex_lock(&w->lock);
+    if (w->count > 0) {
+        *task = w->tasks[w->top];
+        w->top = (w->top + 1) % w->capacity;
+        w->count--;
+        found = 1;
+    }
+    pthread_mutex_unlock(&w->lock);
+    return found;
+}
+
+// Take a task from the own deque first, then try the other workers in turn
+static int find_task(thread_pool_worker *self, thread_pool_task *task) {
+    thread_pool_t *p = self->pool;
+    if (deque_pop_bottom(self, task)) return 1;
+    for (int i = 1; i < p->num_threads; i++) {
+        thread_pool_worker *victim = &p->workers[(self->index + i) % p->num_threads];
+        if (deque_steal_top(victim, task)) return 1;
+    }
+    return 0;
+}
+
+static void *worker_main(void *arg) {
+    thread_pool_worker *self = (thread_pool_worker *)arg;
+    thread_pool_t *p = self->pool;
+    current_worker = self;
+
+    while (1) {
+        thread_pool_task task;
+        if (find_task(self, &task)) {
+            pthread_mutex_lock(&p->idle_lock);
+            p->pending--;
+            pthread_mutex_unlock(&p->idle_lock);
+            task.fn(task.arg);
+            continue;
+        }
+
+        // Nothing to run or steal: park until new work arrives or the pool stops
+        pthread_mutex_lock(&p->idle_lock);
+        while (p->pending == 0 && !p->stopping) {
+            pthread_cond_wait(&p->idle_cond, &p->idle_lock);
+        }
+        int done = (p->pending == 0 && p->stopping);
+        pthread_mutex_unlock(&p->idle_lock);
+        if (done) break;
+    }
+
+    current_worker = NULL;
+    return NULL;
+}
+
+// Stop and join the first 'started' workers, then destroy every initialized worker and free the pool
+static void destroy_pool(thread_pool_t *p, int started) {
+    pthread_mutex_lock(&p->idle_lock);
+    p->stopping = 1;
+    pthread_cond_broadcast(&p->idle_cond);
+    pthread_mutex_unlock(&p->idle_lock);
+
+    for (int i = 0; i < started; i++) {
+        pthread_join(p->workers[i].thread_id, NULL);
+    }
+    for (int i = 0; i < p->num_threads; i++) {
+        pthread_mutex_destroy(&p->workers[i].lock);
+        free(p->workers[i].tasks);
+    }
+    pthread_cond_destroy(&p->idle_cond);
+    pthread_mutex_destroy(&p->idle_lock);
+    free(p->workers);
+    free(p);
+}
+
+int thread_pool_init(thread_pool **pool, int num_threads) {
+    if (pool == NULL) return -1;
+    if (num_threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = cpus > 0 ? (int)cpus : 1;
+    }
+    if (num_threads > THREAD_POOL_MAX_THREADS) num_threads = THREAD_POOL_MAX_THREADS;
+
+    thread_pool_t *new_pool = (thread_pool_t *)malloc(sizeof(thread_pool_t));
+    if (!new_pool) return -1;
+    new_pool->workers = (thread_pool_worker *)calloc(num_threads, sizeof(thread_pool_worker));
+    if (!new_pool->workers) {
+        free(new_pool);
+        return -1;
+    }
+    new_pool->num_threads = num_threads;
+    new_pool->pending = 0;
+    new_pool->stopping = 0;
+    new_pool->next_worker = 0;
+    pthread_mutex_init(&new_pool->idle_lock, NULL);
+    pthread_cond_init(&new_pool->idle_cond, NULL);
+
+    for (int i = 0; i < num_threads; i++) {
+        thread_pool_worker *w = &new_pool->workers[i];
+        w->tasks = (thread_pool_task *)malloc(sizeof(thread_pool_task) * THREAD_POOL_INITIAL_CAPACITY);
+        if (!w->tasks) {
+            new_pool->num_threads = i; // Only workers 0..i-1 were initialized, none started
+            destroy_pool(new_pool, 0);
+            return -1;
+        }
+        w->capacity = THREAD_POOL_INITIAL_CAPACITY;
+        w->top = 0;
+        w->count = 0;
+        w->index = i;
+        w->pool = new_pool;
+        pthread_mutex_init(&w->lock, NULL);
+    }
+
+    for (int i = 0; i < num_threads; i++) {
+        if (pthread_create(&new_pool->workers[i].thread_id, NULL, worker_main, &new_pool->workers[i]) != 0) {
+            printf("Thread pool worker %d creation failed!\n", i);
+            destroy_pool(new_pool, i);
+            return -1;
+        }
+    }
+
+    *pool = (thread_pool *)new_pool;
+    return 0;
+}
+
+int thread_pool_uninit(thread_pool *pool) {
+    if (!pool) return -1;
+    thread_pool_t *p = (thread_pool_t *)pool;
+    destroy_pool(p, p->num_threads);
+    return 0;
+}
+
+int thread_pool_submit(thread_pool *pool, void (*fn)(void *), void *arg) {
+    if (!pool || !fn) return -1;
+    thread_pool_t *p = (thread_pool_t *)pool;
+    thread_pool_task task = { fn, arg };
+
+    // Keep follow-up work local to the submitting worker; spread external work round-robin
+    pthread_mutex_lock(&p->idle_lock);
+    thread_pool_worker *target = current_worker;
+    if (!target || target->pool != p) {
+        target = &p->workers[p->next_worker++ % p->num_threads];
+    }
+    p->pending++;
+    pthread_mutex_unlock(&p->idle_lock);
+
+    if (deque_push_bottom(target, task) != 0) {
+        pthread_mutex_lock(&p->idle_lock);
+        p->pending--;
+        pthread_mutex_unlock(&p->idle_lock);
+        return -1;
+    }
+
+    pthread_mutex_lock(&p->idle_lock);
+    pthread_cond_signal(&p->idle_cond);
+    pthread_mutex_unlock(&p->idle_lock);
+    return 0;
+}
+
+int thread_pool_size(thread_pool *pool) {
+    if (!pool) return 0;
+    return ((thread_pool_t *)pool)->num_threads;
+}
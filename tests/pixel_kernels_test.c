@@ -0,0 +1,37 @@
+// High-Level Explanation:
+// This test checks every pixel kernel variant built for the host against the scalar reference.
+// It runs under ctest, so a variant that disagrees with the reference fails the build check instead of only being
+// skipped at runtime by the dispatcher.
+
+// Important Functions:
+// - main: Lists the available variants, runs pixel_kernels_self_check, and checks the dispatcher picked a variant.
+
+// Inputs and Outputs:
+// - Inputs: None.
+// - Outputs: Mismatch report on stdout, return code (0 if every variant matches).
+
+#include "pixel_kernels.h"
+#include <stdio.h>
+
+int main(void) {
+    static const char *isa_names[PIXEL_ISA_COUNT] = { "scalar", "sse4", "avx2", "neon" };
+    int failed = 0;
+
+    for (int isa = 0; isa < PIXEL_ISA_COUNT; isa++) {
+        const pixel_kernels *variant = pixel_kernels_get_variant((pixel_isa)isa);
+        printf("%-6s %s\n", isa_names[isa], variant ? "checked" : "not available on this build/CPU");
+    }
+    if (pixel_kernels_self_check() != 0) {
+        printf("FAIL: a pixel kernel variant differs from the scalar reference\n");
+        failed = 1;
+    }
+
+    const pixel_kernels *selected = pixel_kernels_get();
+    if (!selected || !selected->blend || !selected->gain || !selected->average_rows ||
+        !selected->scale_row_nearest) {
+        printf("FAIL: no usable kernel table selected\n");
+        failed = 1;
+    }
+    if (!failed) printf("PASS: all variants match the scalar reference (selected %s)\n", selected->name);
+    return failed;
+}